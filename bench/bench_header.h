@@ -0,0 +1,58 @@
+#pragma once
+/// Header to be included in benchmarks and benchmarks only. Provides a minimal
+/// timing harness, since pulling in a benchmarking library for a handful of
+/// throughput measurements is not worth it.
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace bench {
+/// Prevent the compiler from optimizing away a computed value.
+template <typename T> inline void do_not_optimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+/// Prevent the compiler from assuming memory has not changed between calls.
+inline void clobber_memory()
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+/// Run operation until at least min_seconds have passed, and return the
+/// average number of nanoseconds it took per call.
+template <typename Operation>
+inline double time_ns(Operation&& operation, double min_seconds = 0.2)
+{
+    using clock = std::chrono::steady_clock;
+    // warm up caches and branch predictors
+    operation();
+
+    size_t iterations = 1;
+    while (true) {
+        const auto start = clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            operation();
+        }
+        const std::chrono::duration<double> elapsed = clock::now() - start;
+        if (elapsed.count() >= min_seconds) {
+            return (elapsed.count() * 1e9) / double(iterations);
+        }
+        iterations *= 2;
+    }
+}
+
+/// Print one row of a throughput table.
+inline void report(const char* name, size_t bytes, double ns)
+{
+    std::printf("%-32s %10zu B %12.2f ns %10.4f ns/B %10.2f GB/s\n", name,
+                bytes, ns, ns / double(bytes), double(bytes) / ns);
+}
+} // namespace bench
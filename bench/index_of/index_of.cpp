@@ -0,0 +1,64 @@
+#include "bench_header.h"
+// bench header must be first
+#include "ziglike/stdmem.h"
+#include "ziglike/zigstdint.h"
+#include <string>
+#include <string_view>
+
+#if __has_include(<string.h>) && (defined(__GLIBC__) || defined(__APPLE__))
+#include <string.h>
+#define HAS_MEMMEM
+#endif
+
+using namespace zl;
+
+int main()
+{
+    constexpr size_t haystack_size = 1 << 20;
+    // english-ish text, so that first and last bytes of the needle show up
+    // all over the haystack
+    const std::string_view words[] = {"the ", "quick ", "brown ", "fox ",
+                                      "jumps ", "over ", "lazy ", "dogs "};
+    std::string haystack;
+    u32 state = 1;
+    while (haystack.size() < haystack_size) {
+        state = state * 1664525 + 1013904223;
+        haystack += words[(state >> 16) % 8];
+    }
+    haystack.resize(haystack_size);
+
+    std::printf("substring search in %zu bytes of text, needle at the end\n",
+                haystack_size);
+    for (size_t needle_size : {2UL, 4UL, 8UL, 16UL, 32UL, 64UL, 256UL}) {
+        // a needle made of the text's own words, which only occurs at the end
+        std::string needle = haystack.substr(1000, needle_size);
+        needle[needle_size / 2] = '#';
+        std::string text = haystack;
+        text.replace(text.size() - needle_size, needle_size, needle);
+
+        const std::string_view view(text);
+        slice<const char> text_slice = raw_slice(*text.data(), text.size());
+        slice<const char> needle_slice =
+            raw_slice(*needle.data(), needle.size());
+
+        std::printf("needle of %zu bytes\n", needle_size);
+        bench::report("std::string_view::find", text.size(),
+                      bench::time_ns([&] {
+                          bench::clobber_memory();
+                          bench::do_not_optimize(view.find(needle));
+                      }));
+#ifdef HAS_MEMMEM
+        bench::report("memmem", text.size(), bench::time_ns([&] {
+                          bench::clobber_memory();
+                          bench::do_not_optimize(
+                              memmem(text.data(), text.size(), needle.data(),
+                                     needle.size()));
+                      }));
+#endif
+        bench::report("zl::index_of", text.size(), bench::time_ns([&] {
+                          bench::clobber_memory();
+                          bench::do_not_optimize(
+                              index_of(text_slice, needle_slice));
+                      }));
+    }
+}
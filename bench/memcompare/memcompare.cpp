@@ -0,0 +1,49 @@
+#include "bench_header.h"
+// bench header must be first
+#include "ziglike/stdmem.h"
+#include "ziglike/zigstdint.h"
+#include <cstring>
+#include <vector>
+
+using namespace zl;
+
+/// The loop memcompare used before it was vectorized, kept as a baseline.
+static bool scalar_memcompare(slice<const u8> a, slice<const u8> b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a.data()[i] != b.data()[i])
+            return false;
+    }
+    return true;
+}
+
+int main()
+{
+    std::printf("memcompare of equal buffers (worst case, full scan)\n");
+    for (size_t size : {16UL, 64UL, 256UL, 1024UL, 4096UL, 16384UL, 65536UL,
+                        1048576UL}) {
+        std::vector<u8> a(size);
+        for (size_t i = 0; i < size; ++i) {
+            a[i] = u8(i * 31);
+        }
+        std::vector<u8> b = a;
+        slice<const u8> sa(a);
+        slice<const u8> sb(b);
+
+        bench::report("scalar loop", size, bench::time_ns([&] {
+                          bench::clobber_memory();
+                          bench::do_not_optimize(scalar_memcompare(sa, sb));
+                      }));
+        bench::report("std::memcmp", size, bench::time_ns([&] {
+                          bench::clobber_memory();
+                          bench::do_not_optimize(
+                              std::memcmp(sa.data(), sb.data(), size) == 0);
+                      }));
+        bench::report("zl::memcompare", size, bench::time_ns([&] {
+                          bench::clobber_memory();
+                          bench::do_not_optimize(memcompare(sa, sb));
+                      }));
+    }
+}
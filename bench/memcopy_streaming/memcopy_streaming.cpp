@@ -0,0 +1,83 @@
+#include "bench_header.h"
+// bench header must be first
+#include "ziglike/stdmem.h"
+#include "ziglike/zigstdint.h"
+#include <chrono>
+#include <vector>
+
+using namespace zl;
+
+/// The cost of a cache polluting copy is not the copy itself, it is the
+/// misses taken afterwards by whatever the program was doing before it. So this
+/// measures a hot lookup table workload which runs after each large copy: the
+/// more of the table the copy evicted, the slower the workload gets.
+
+static constexpr size_t table_size = 256 * 1024; // u32 entries, 1 MiB
+static constexpr size_t lookups = 1 << 16;
+
+static u32 workload(const std::vector<u32>& table)
+{
+    u32 index = 0;
+    u32 sum = 0;
+    for (size_t i = 0; i < lookups; ++i) {
+        index = (index * 1664525 + 1013904223) % table_size;
+        sum += table[index];
+    }
+    return sum;
+}
+
+/// Average time of the workload alone, when it runs right after copy().
+template <typename Copy>
+static double workload_after(Copy&& copy, const std::vector<u32>& table)
+{
+    using clock = std::chrono::steady_clock;
+    constexpr size_t rounds = 20;
+    std::chrono::duration<double> total{};
+    for (size_t i = 0; i < rounds; ++i) {
+        // warm the table back up, then disturb the cache
+        bench::do_not_optimize(workload(table));
+        copy();
+        bench::clobber_memory();
+        const auto start = clock::now();
+        bench::do_not_optimize(workload(table));
+        total += clock::now() - start;
+    }
+    return (total.count() * 1e9) / double(rounds);
+}
+
+int main()
+{
+    std::vector<u32> table(table_size);
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i] = u32(i * 2654435761U);
+    }
+
+    std::printf("hot 1 MiB table lookups after a large copy\n");
+    for (size_t size : {size_t(1) << 20, size_t(16) << 20, size_t(128) << 20}) {
+        std::vector<u8> source(size, 1);
+        std::vector<u8> destination(size, 0);
+        slice<u8> src(source);
+        slice<u8> dst(destination);
+
+        std::printf("copy of %zu bytes\n", size);
+        bench::report("memcopy", size, bench::time_ns([&] {
+                          memcopy(dst, src);
+                          bench::clobber_memory();
+                      }));
+        bench::report("memcopy_streaming", size, bench::time_ns([&] {
+                          memcopy_streaming(dst, src, 0);
+                          bench::clobber_memory();
+                      }));
+
+        const double alone = workload_after([] {}, table);
+        const double after_memcopy =
+            workload_after([&] { memcopy(dst, src); }, table);
+        const double after_streaming =
+            workload_after([&] { memcopy_streaming(dst, src, 0); }, table);
+        std::printf("  workload alone            %12.2f ns\n", alone);
+        std::printf("  workload after memcopy    %12.2f ns (%+.2f ns)\n",
+                    after_memcopy, after_memcopy - alone);
+        std::printf("  workload after streaming  %12.2f ns (%+.2f ns)\n",
+                    after_streaming, after_streaming - alone);
+    }
+}
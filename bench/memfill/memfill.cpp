@@ -0,0 +1,49 @@
+#include "bench_header.h"
+// bench header must be first
+#include "ziglike/stdmem.h"
+#include "ziglike/zigstdint.h"
+#include <vector>
+
+using namespace zl;
+
+/// The loop memfill used for every type but u8 before it was vectorized.
+template <typename T> static void loop_memfill(slice<T> slice, const T original)
+{
+    for (T& item : slice) {
+        new ((void*)std::addressof(item)) T(original);
+    }
+}
+
+template <typename T> static void run(const char* type_name, T value)
+{
+    std::printf("memfill of %s\n", type_name);
+    for (size_t count : {64UL, 1024UL, 16384UL, 262144UL, 16777216UL}) {
+        std::vector<T> buffer(count);
+        slice<T> memory(buffer);
+        const size_t bytes = count * sizeof(T);
+
+        bench::report("placement new loop", bytes, bench::time_ns([&] {
+                          loop_memfill(memory, value);
+                          bench::clobber_memory();
+                      }));
+        bench::report("zl::memfill", bytes, bench::time_ns([&] {
+                          memfill(memory, value);
+                          bench::clobber_memory();
+                      }));
+        bench::report("zl::memfill_streaming", bytes, bench::time_ns([&] {
+                          memfill_streaming(memory, value);
+                          bench::clobber_memory();
+                      }));
+    }
+}
+
+int main()
+{
+    run<u32>("u32", 0xDEADBEEF);
+    run<f32>("f32", 1.5f);
+    struct rgb
+    {
+        u8 r, g, b;
+    };
+    run<rgb>("3 byte struct", rgb{1, 2, 3});
+}
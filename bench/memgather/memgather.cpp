@@ -0,0 +1,45 @@
+#include "bench_header.h"
+// bench header must be first
+#include "ziglike/stdmem.h"
+#include "ziglike/zigstdint.h"
+#include <vector>
+
+using namespace zl;
+
+/// Copying a column out by indexing, as done before strided_slice existed.
+template <typename T>
+static void loop_gather(slice<T> destination, const T* source, size_t stride)
+{
+    for (size_t i = 0; i < destination.size(); ++i)
+        destination.data()[i] = source[i * stride];
+}
+
+template <typename T> static void run(const char* type_name)
+{
+    std::printf("memgather of %s\n", type_name);
+    for (size_t stride : {2UL, 4UL, 16UL}) {
+        for (size_t count : {1024UL, 65536UL, 1048576UL}) {
+            std::vector<T> matrix(count * stride, T(1));
+            std::vector<T> column(count);
+            slice<T> destination(column);
+            const strided_slice<T> source(slice<T>(matrix), 0, stride);
+            const size_t bytes = count * sizeof(T);
+
+            std::printf("stride %zu\n", stride);
+            bench::report("index loop", bytes, bench::time_ns([&] {
+                              loop_gather(destination, matrix.data(), stride);
+                              bench::clobber_memory();
+                          }));
+            bench::report("zl::memgather", bytes, bench::time_ns([&] {
+                              memgather(destination, source);
+                              bench::clobber_memory();
+                          }));
+        }
+    }
+}
+
+int main()
+{
+    run<f32>("f32");
+    run<f64>("f64");
+}
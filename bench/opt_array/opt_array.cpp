@@ -0,0 +1,65 @@
+#include "bench_header.h"
+// bench header must be first
+#include "ziglike/opt_array.h"
+#include "ziglike/zigstdint.h"
+#include <array>
+#include <cstdlib>
+#include <memory>
+
+using namespace zl;
+
+// a multiple of 64, so that the masked scan can work a word at a time
+constexpr size_t items = 1 << 16;
+
+/// Sum the present items of an array of opt<u32>, an opt_array visited with
+/// for_each, and an opt_array scanned over every slot and masked with the
+/// bitmap, at several densities.
+static void run(unsigned percent_present)
+{
+    auto optionals = std::make_unique<std::array<opt<u32>, items>>();
+    auto packed = std::make_unique<opt_array<u32, items>>();
+    std::srand(1);
+    for (size_t i = 0; i < items; ++i) {
+        if (unsigned(std::rand() % 100) < percent_present) {
+            (*optionals)[i] = u32(i);
+            packed->emplace(i, u32(i));
+        }
+    }
+    std::printf("summing %zu optional u32s, %u%% present\n", items,
+                percent_present);
+
+    bench::report("array of zl::opt", sizeof(*optionals), bench::time_ns([&] {
+                      u64 total = 0;
+                      for (const opt<u32>& item : *optionals)
+                          if (item.has_value())
+                              total += item.value();
+                      bench::do_not_optimize(total);
+                  }));
+    bench::report("opt_array for_each", sizeof(*packed), bench::time_ns([&] {
+                      u64 total = 0;
+                      packed->for_each(
+                          [&total](size_t, u32 item) { total += item; });
+                      bench::do_not_optimize(total);
+                  }));
+    bench::report("opt_array masked scan", sizeof(*packed),
+                  bench::time_ns([&] {
+                      const slice<const u32> slots =
+                          std::as_const(*packed).items();
+                      const slice<const u64> presence = packed->presence();
+                      u64 total = 0;
+                      for (size_t w = 0; w < presence.size(); ++w) {
+                          const u64 bits = presence[w];
+                          const u32* block = slots.data() + w * 64;
+                          for (u32 i = 0; i < 64; ++i)
+                              total += block[i] & (0U - u32((bits >> i) & 1));
+                      }
+                      bench::do_not_optimize(total);
+                  }));
+}
+
+int main()
+{
+    run(1);
+    run(50);
+    run(99);
+}
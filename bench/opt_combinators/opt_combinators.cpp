@@ -0,0 +1,120 @@
+#include "bench_header.h"
+// bench header must be first
+#include "ziglike/opt.h"
+#include "ziglike/zigstdint.h"
+#include <array>
+#include <memory>
+
+using namespace zl;
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE __declspec(noinline)
+#endif
+
+/// A payload which is expensive to copy.
+struct big
+{
+    std::array<u64, 16> words;
+};
+
+/// Pairs of functions which should compile to the same code, one written with
+/// has_value() and value(), the other with combinators. They cannot be inlined
+/// so that they can be disassembled and compared.
+BENCH_NOINLINE f64 scale_branch(const opt<f64>& maybe)
+{
+    return maybe.has_value() ? maybe.value() * 2.0 : 1.0;
+}
+
+BENCH_NOINLINE f64 scale_combinator(const opt<f64>& maybe)
+{
+    return maybe.transform([](f64 value) { return value * 2.0; }).value_or(1.0);
+}
+
+BENCH_NOINLINE u64 first_word_branch(const opt<big>& maybe)
+{
+    if (!maybe.has_value())
+        return 0;
+    return maybe.value().words[0];
+}
+
+BENCH_NOINLINE u64 first_word_combinator(const opt<big>& maybe)
+{
+    return maybe.transform([](const big& item) { return item.words[0]; })
+        .value_or(u64(0));
+}
+
+BENCH_NOINLINE u64 second_word_branch(const opt<big&> maybe)
+{
+    if (!maybe.has_value())
+        return 0;
+    return maybe.value().words[1];
+}
+
+BENCH_NOINLINE u64 second_word_combinator(const opt<big&> maybe)
+{
+    return maybe.transform([](big& item) { return item.words[1]; })
+        .value_or(u64(0));
+}
+
+int main()
+{
+    constexpr size_t count = 4096;
+    auto values = std::make_unique<std::array<opt<f64>, count>>();
+    auto bigs = std::make_unique<std::array<opt<big>, count>>();
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 3 != 0) {
+            (*values)[i] = f64(i);
+            (*bigs)[i] = big{{u64(i), u64(i) + 1}};
+        }
+    }
+
+    std::printf("mapping %zu optional f64s\n", count);
+    bench::report("has_value and value", sizeof(*values), bench::time_ns([&] {
+                      f64 total = 0;
+                      for (const opt<f64>& maybe : *values)
+                          total += scale_branch(maybe);
+                      bench::do_not_optimize(total);
+                  }));
+    bench::report("transform and value_or", sizeof(*values),
+                  bench::time_ns([&] {
+                      f64 total = 0;
+                      for (const opt<f64>& maybe : *values)
+                          total += scale_combinator(maybe);
+                      bench::do_not_optimize(total);
+                  }));
+
+    std::printf("reading a word of %zu optional %zu byte structs\n", count,
+                sizeof(big));
+    bench::report("has_value and value", sizeof(*bigs), bench::time_ns([&] {
+                      u64 total = 0;
+                      for (const opt<big>& maybe : *bigs)
+                          total += first_word_branch(maybe);
+                      bench::do_not_optimize(total);
+                  }));
+    bench::report("transform and value_or", sizeof(*bigs), bench::time_ns([&] {
+                      u64 total = 0;
+                      for (const opt<big>& maybe : *bigs)
+                          total += first_word_combinator(maybe);
+                      bench::do_not_optimize(total);
+                  }));
+
+    std::printf("reading a word through %zu optional references\n", count);
+    bench::report("has_value and value", sizeof(*bigs), bench::time_ns([&] {
+                      u64 total = 0;
+                      for (opt<big>& maybe : *bigs)
+                          total += second_word_branch(
+                              maybe.has_value() ? opt<big&>(maybe.value())
+                                                : opt<big&>());
+                      bench::do_not_optimize(total);
+                  }));
+    bench::report("transform and value_or", sizeof(*bigs), bench::time_ns([&] {
+                      u64 total = 0;
+                      for (opt<big>& maybe : *bigs)
+                          total += second_word_combinator(
+                              maybe.has_value() ? opt<big&>(maybe.value())
+                                                : opt<big&>());
+                      bench::do_not_optimize(total);
+                  }));
+}
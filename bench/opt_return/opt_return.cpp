@@ -0,0 +1,81 @@
+#include "bench_header.h"
+// bench header must be first
+#include "ziglike/opt.h"
+#include "ziglike/zigstdint.h"
+#include <type_traits>
+
+using namespace zl;
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE __declspec(noinline)
+#endif
+
+static_assert(std::is_trivially_copyable_v<opt<i32>> &&
+                  std::is_trivially_copyable_v<opt<f64>>,
+              "opt of a trivial type must be trivial to be passed in "
+              "registers");
+
+/// What opt<T> should compile to: a trivial pair, which the Itanium ABI
+/// returns in registers.
+template <typename T> struct plain_optional
+{
+    bool has_value;
+    T value;
+};
+
+/// Functions which cannot be inlined, so that every call goes through the
+/// ABI. Disassemble these to see whether the result is returned in registers
+/// or through a pointer to memory on the caller's stack.
+template <typename T> BENCH_NOINLINE opt<T> make_opt(u32 input)
+{
+    if (input % 3 == 0)
+        return {};
+    return T(input);
+}
+
+template <typename T> BENCH_NOINLINE plain_optional<T> make_plain(u32 input)
+{
+    if (input % 3 == 0)
+        return {false, T()};
+    return {true, T(input)};
+}
+
+template <typename T> BENCH_NOINLINE T add_opt(opt<T> maybe, T total)
+{
+    return maybe.has_value() ? total + maybe.value() : total;
+}
+
+template <typename T>
+BENCH_NOINLINE T add_plain(plain_optional<T> maybe, T total)
+{
+    return maybe.has_value ? total + maybe.value : total;
+}
+
+template <typename T> static void run(const char* type_name)
+{
+    constexpr u32 calls = 4096;
+    const size_t bytes = calls * sizeof(T);
+    std::printf("returning and passing an optional %s, %u calls\n", type_name,
+                calls);
+
+    bench::report("plain struct", bytes, bench::time_ns([] {
+                      T total = T(0);
+                      for (u32 i = 0; i < calls; ++i)
+                          total = add_plain<T>(make_plain<T>(i), total);
+                      bench::do_not_optimize(total);
+                  }));
+    bench::report("zl::opt", bytes, bench::time_ns([] {
+                      T total = T(0);
+                      for (u32 i = 0; i < calls; ++i)
+                          total = add_opt<T>(make_opt<T>(i), total);
+                      bench::do_not_optimize(total);
+                  }));
+}
+
+int main()
+{
+    run<i32>("i32");
+    run<f64>("f64");
+}
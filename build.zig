@@ -33,6 +33,32 @@ const test_source_files = &[_][]const u8{
     "defer/defer.cpp",
     "stdmem/stdmem.cpp",
     "enumerate/enumerate.cpp",
+    "split/split.cpp",
+    "strided_slice/strided_slice.cpp",
+    "mdslice/mdslice.cpp",
+    "fixed_slice/fixed_slice.cpp",
+    "aligned_slice/aligned_slice.cpp",
+    "io/io.cpp",
+    "niche/niche.cpp",
+    "opt_array/opt_array.cpp",
+};
+
+const bench_flags = &[_][]const u8{
+    "-DNDEBUG",
+    "-std=c++17",
+    "-I./bench/",
+    "-I./include/",
+};
+
+const bench_source_files = &[_][]const u8{
+    "memcompare/memcompare.cpp",
+    "memfill/memfill.cpp",
+    "memcopy_streaming/memcopy_streaming.cpp",
+    "index_of/index_of.cpp",
+    "memgather/memgather.cpp",
+    "opt_return/opt_return.cpp",
+    "opt_array/opt_array.cpp",
+    "opt_combinators/opt_combinators.cpp",
 };
 
 pub fn build(b: *std.Build) !void {
@@ -95,5 +121,26 @@ pub fn build(b: *std.Build) !void {
         run_tests_step.dependOn(&test_run.step);
     }
 
+    // benchmarks are always built in release mode, for the native cpu, so that
+    // the vectorized paths are selected
+    const run_benches_step = b.step("run_benches", "Compile and run all the benchmarks");
+    for (bench_source_files) |source_file| {
+        var bench_exe = b.addExecutable(.{
+            .name = b.fmt("bench_{s}", .{std.fs.path.stem(source_file)}),
+            .optimize = .ReleaseFast,
+            .target = b.host,
+        });
+        bench_exe.addCSourceFile(.{
+            .file = .{ .src_path = .{
+                .owner = b,
+                .sub_path = b.pathJoin(&.{ "bench", source_file }),
+            } },
+            .flags = bench_flags,
+        });
+        bench_exe.linkLibCpp();
+        const bench_run = b.addRunArtifact(bench_exe);
+        run_benches_step.dependOn(&bench_run.step);
+    }
+
     zcc.createStep(b, "cdb", try tests.toOwnedSlice());
 }
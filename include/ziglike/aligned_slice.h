@@ -0,0 +1,165 @@
+#pragma once
+#include "ziglike/detail/abort.h"
+#include "ziglike/detail/bounds_check.h"
+#include "ziglike/slice.h"
+#include <cstdint>
+#include <memory>
+
+#ifndef ZIGLIKE_NOEXCEPT
+#define ZIGLIKE_NOEXCEPT noexcept
+#endif
+
+namespace zl {
+namespace detail {
+/// Tell the compiler that pointer is aligned to Align bytes.
+template <size_t Align, typename T>
+inline T* assume_aligned(T* pointer) noexcept
+{
+#if defined(__cpp_lib_assume_aligned)
+    return std::assume_aligned<Align>(pointer);
+#elif defined(__GNUC__) || defined(__clang__)
+    return static_cast<T*>(__builtin_assume_aligned(pointer, Align));
+#else
+    return pointer;
+#endif
+}
+} // namespace detail
+
+/// A slice whose first item is known to be aligned to Align bytes, for
+/// buffers which come from aligned allocators. Alignment is checked once at
+/// construction, after which data() tells the compiler about it, and the
+/// stdmem overloads for aligned slices use aligned vector loads and stores.
+template <typename T, size_t Align> class aligned_slice
+{
+  private:
+    static_assert(Align != 0 && (Align & (Align - 1)) == 0,
+                  "Alignment must be a power of two");
+    static_assert(Align >= alignof(T),
+                  "Alignment must be at least the alignment of T");
+
+    T* m_data;
+    size_t m_elements;
+
+    using TNonConst = std::remove_const_t<T>;
+
+    template <typename, size_t> friend class aligned_slice;
+
+  public:
+    using type = T;
+    using value_type = T;
+
+    static constexpr size_t alignment = Align;
+
+    /// Returns true if the first item of other is aligned to Align bytes.
+    [[nodiscard]] static inline bool
+    is_aligned(slice<T> other) ZIGLIKE_NOEXCEPT
+    {
+        return reinterpret_cast<uintptr_t>(other.data()) % Align == 0;
+    }
+
+    /// Reference the items of other. Aborts if its first item is not aligned
+    /// to Align bytes.
+    inline explicit aligned_slice(slice<T> other) ZIGLIKE_NOEXCEPT
+        : m_data(other.data()),
+          m_elements(other.size())
+    {
+        if (!is_aligned(other)) [[unlikely]]
+            ZIGLIKE_ABORT();
+    }
+
+    /// Can be made from an aligned slice of nonconst items, or of items with
+    /// a greater alignment.
+    template <typename U, size_t OtherAlign,
+              typename = std::enable_if_t<
+                  (std::is_same_v<U, T> ||
+                   (std::is_const_v<T> && std::is_same_v<U, TNonConst>)) &&
+                  OtherAlign >= Align>>
+    inline constexpr aligned_slice(const aligned_slice<U, OtherAlign>& other)
+        ZIGLIKE_NOEXCEPT : m_data(other.m_data),
+                           m_elements(other.m_elements)
+    {
+    }
+
+    aligned_slice() = delete;
+
+    /// Convert to a regular slice of T or const T.
+    template <typename U,
+              typename = std::enable_if_t<std::is_same_v<U, T> ||
+                                          std::is_same_v<U, const T>>>
+    inline constexpr operator slice<U>() const ZIGLIKE_NOEXCEPT
+    {
+        return raw_slice<U>(*m_data, m_elements);
+    }
+
+    /// Pointer to the first item, annotated as aligned to Align bytes.
+    [[nodiscard]] inline T* data() const ZIGLIKE_NOEXCEPT
+    {
+        return detail::assume_aligned<Align>(m_data);
+    }
+    [[nodiscard]] inline constexpr size_t size() const ZIGLIKE_NOEXCEPT
+    {
+        return m_elements;
+    }
+
+    /// Access the item at index. Bounds checked according to
+    /// ZIGLIKE_BOUNDS_CHECK, like slice::operator[].
+    [[nodiscard]] inline T& operator[](size_t index) const ZIGLIKE_NOEXCEPT
+    {
+#ifdef ZIGLIKE_BOUNDS_CHECKED
+        if (index >= m_elements) [[unlikely]]
+            ZIGLIKE_ABORT();
+#endif
+        return data()[index];
+    }
+
+    /// Access the item at index, or null if index is out of bounds.
+    template <typename U = T>
+    [[nodiscard]] inline opt<U&> at(size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        if (index >= m_elements)
+            return {};
+        return data()[index];
+    }
+
+    /// Access the item at index without ever checking bounds.
+    [[nodiscard]] inline T& unchecked_at(size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        return data()[index];
+    }
+
+    /// The first count items, which keep the alignment. Aborts if count is
+    /// greater than size().
+    [[nodiscard]] inline aligned_slice first(size_t count) const
+        ZIGLIKE_NOEXCEPT
+    {
+        if (count > m_elements) [[unlikely]]
+            ZIGLIKE_ABORT();
+        aligned_slice out = *this;
+        out.m_elements = count;
+        return out;
+    }
+
+    inline constexpr friend bool
+    operator==(const aligned_slice& a, const aligned_slice& b) ZIGLIKE_NOEXCEPT
+    {
+        return a.m_elements == b.m_elements && a.m_data == b.m_data;
+    }
+
+    inline constexpr friend bool
+    operator!=(const aligned_slice& a, const aligned_slice& b) ZIGLIKE_NOEXCEPT
+    {
+        return !(a == b);
+    }
+
+#ifndef ZIGLIKE_SLICE_NO_ITERATOR
+    using iterator = typename slice<T>::iterator;
+    using const_iterator = typename slice<T>::const_iterator;
+
+    inline iterator begin() const ZIGLIKE_NOEXCEPT { return iterator(data()); }
+    inline iterator end() const ZIGLIKE_NOEXCEPT
+    {
+        return iterator(data() + m_elements);
+    }
+#endif
+};
+} // namespace zl
@@ -0,0 +1,21 @@
+#pragma once
+// Defines the ZIGLIKE_BOUNDS_CHECK policy used by the indexing functions of
+// slice. Set ZIGLIKE_BOUNDS_CHECK to one of the following before including
+// ziglike headers:
+//  - ZIGLIKE_BOUNDS_CHECK_ALWAYS: always abort on out of bounds access
+//  - ZIGLIKE_BOUNDS_CHECK_DEBUG: only check when NDEBUG is not defined (the
+//    default)
+//  - ZIGLIKE_BOUNDS_CHECK_NEVER: never check, indexing is a bare load
+
+#define ZIGLIKE_BOUNDS_CHECK_NEVER 0
+#define ZIGLIKE_BOUNDS_CHECK_DEBUG 1
+#define ZIGLIKE_BOUNDS_CHECK_ALWAYS 2
+
+#ifndef ZIGLIKE_BOUNDS_CHECK
+#define ZIGLIKE_BOUNDS_CHECK ZIGLIKE_BOUNDS_CHECK_DEBUG
+#endif
+
+#if ZIGLIKE_BOUNDS_CHECK == ZIGLIKE_BOUNDS_CHECK_ALWAYS ||                     \
+    (ZIGLIKE_BOUNDS_CHECK == ZIGLIKE_BOUNDS_CHECK_DEBUG && !defined(NDEBUG))
+#define ZIGLIKE_BOUNDS_CHECKED
+#endif
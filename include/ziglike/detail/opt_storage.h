@@ -0,0 +1,241 @@
+#pragma once
+// Storage for opt<T> when T is not a reference or a slice. The special member
+// functions are split into layers which are only user-provided when the
+// corresponding operation on T is non-trivial, so that opt<T> is trivially
+// copyable and destructible whenever T is, and can be passed in registers.
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef ZIGLIKE_NOEXCEPT
+#define ZIGLIKE_NOEXCEPT noexcept
+#endif
+
+// Non-trivial destructors can only be constexpr from C++20. Payloads which are
+// trivially destructible work in constant expressions in C++17 as well.
+#ifdef __cpp_constexpr_dynamic_alloc
+#define ZIGLIKE_CONSTEXPR_DESTRUCTOR constexpr
+#else
+#define ZIGLIKE_CONSTEXPR_DESTRUCTOR
+#endif
+
+namespace zl::detail {
+/// Union of a payload and nothing. Also used by res.
+template <typename T, bool = std::is_trivially_destructible_v<T>>
+union opt_union
+{
+    uint8_t none;
+    T some;
+
+    inline constexpr opt_union() ZIGLIKE_NOEXCEPT : none(0) {}
+
+    template <typename... Args>
+    inline constexpr explicit opt_union(std::in_place_t,
+                                        Args&&... args) ZIGLIKE_NOEXCEPT
+        : some(std::forward<Args>(args)...)
+    {
+    }
+};
+
+template <typename T> union opt_union<T, false>
+{
+    uint8_t none;
+    T some;
+
+    inline constexpr opt_union() ZIGLIKE_NOEXCEPT : none(0) {}
+
+    template <typename... Args>
+    inline constexpr explicit opt_union(std::in_place_t,
+                                        Args&&... args) ZIGLIKE_NOEXCEPT
+        : some(std::forward<Args>(args)...)
+    {
+    }
+
+    inline ZIGLIKE_CONSTEXPR_DESTRUCTOR ~opt_union() ZIGLIKE_NOEXCEPT {}
+};
+
+template <typename T, bool = std::is_trivially_destructible_v<T>>
+struct opt_storage
+{
+    bool has_value = false;
+    opt_union<T> value;
+
+    opt_storage() = default;
+
+    template <typename... Args>
+    inline constexpr explicit opt_storage(std::in_place_t,
+                                          Args&&... args) ZIGLIKE_NOEXCEPT
+        : has_value(true),
+          value(std::in_place, std::forward<Args>(args)...)
+    {
+    }
+};
+
+template <typename T> struct opt_storage<T, false>
+{
+    bool has_value = false;
+    opt_union<T> value;
+
+    opt_storage() = default;
+
+    template <typename... Args>
+    inline constexpr explicit opt_storage(std::in_place_t,
+                                          Args&&... args) ZIGLIKE_NOEXCEPT
+        : has_value(true),
+          value(std::in_place, std::forward<Args>(args)...)
+    {
+    }
+
+    inline ZIGLIKE_CONSTEXPR_DESTRUCTOR ~opt_storage() ZIGLIKE_NOEXCEPT
+    {
+        if (has_value)
+            value.some.~T();
+    }
+};
+
+template <typename T> struct opt_operations : opt_storage<T>
+{
+    using opt_storage<T>::opt_storage;
+
+    /// Construct the payload. There must not be one already. Only usable in
+    /// constant expressions from C++20, before then the whole storage has to be
+    /// assigned instead.
+    template <typename... Args>
+    inline constexpr void construct(Args&&... args) ZIGLIKE_NOEXCEPT
+    {
+#ifdef __cpp_lib_constexpr_dynamic_alloc
+        std::construct_at(std::addressof(this->value.some),
+                          std::forward<Args>(args)...);
+#else
+        new (std::addressof(this->value.some)) T(std::forward<Args>(args)...);
+#endif
+        this->has_value = true;
+    }
+
+    /// Destroy the payload, if there is one.
+    inline constexpr void destroy() ZIGLIKE_NOEXCEPT
+    {
+        if (this->has_value) {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+                this->value.some.~T();
+            this->has_value = false;
+        }
+    }
+};
+
+template <typename T, bool = std::is_trivially_copy_constructible_v<T> &&
+                             std::is_trivially_move_constructible_v<T>>
+struct opt_construct_layer : opt_operations<T>
+{
+    using opt_operations<T>::opt_operations;
+};
+
+template <typename T> struct opt_construct_layer<T, false> : opt_operations<T>
+{
+    using opt_operations<T>::opt_operations;
+
+    opt_construct_layer() = default;
+
+    inline constexpr opt_construct_layer(const opt_construct_layer& other)
+        ZIGLIKE_NOEXCEPT
+    {
+        if (other.has_value)
+            this->construct(other.value.some);
+    }
+
+    inline constexpr opt_construct_layer(opt_construct_layer&& other)
+        ZIGLIKE_NOEXCEPT
+    {
+        static_assert(std::is_nothrow_move_constructible_v<T>,
+                      "Attempt to move an opt, but the move constructor of "
+                      "the type can throw an exception.");
+        if (other.has_value)
+            this->construct(std::move(other.value.some));
+    }
+
+    opt_construct_layer& operator=(const opt_construct_layer&) = default;
+    opt_construct_layer& operator=(opt_construct_layer&&) = default;
+};
+
+/// Like the assignment operators of opt which take a T, assigning an opt
+/// destroys the old payload and constructs the new one instead of invoking
+/// T's assignment operators.
+template <typename T, bool = std::is_trivially_copy_constructible_v<T> &&
+                             std::is_trivially_move_constructible_v<T> &&
+                             std::is_trivially_copy_assignable_v<T> &&
+                             std::is_trivially_move_assignable_v<T> &&
+                             std::is_trivially_destructible_v<T>>
+struct opt_assign_layer : opt_construct_layer<T>
+{
+    using opt_construct_layer<T>::opt_construct_layer;
+};
+
+template <typename T>
+struct opt_assign_layer<T, false> : opt_construct_layer<T>
+{
+    using opt_construct_layer<T>::opt_construct_layer;
+
+    opt_assign_layer() = default;
+    opt_assign_layer(const opt_assign_layer&) = default;
+    opt_assign_layer(opt_assign_layer&&) = default;
+
+    inline constexpr opt_assign_layer&
+    operator=(const opt_assign_layer& other) ZIGLIKE_NOEXCEPT
+    {
+        if (this != std::addressof(other)) {
+            this->destroy();
+            if (other.has_value)
+                this->construct(other.value.some);
+        }
+        return *this;
+    }
+
+    inline constexpr opt_assign_layer&
+    operator=(opt_assign_layer&& other) ZIGLIKE_NOEXCEPT
+    {
+        if (this != std::addressof(other)) {
+            this->destroy();
+            if (other.has_value)
+                this->construct(std::move(other.value.some));
+        }
+        return *this;
+    }
+};
+
+/// Empty bases which delete copying or moving of opt<T> when T cannot be
+/// copied or moved.
+template <bool copyable> struct opt_copy_control
+{};
+
+template <> struct opt_copy_control<false>
+{
+    opt_copy_control() = default;
+    opt_copy_control(const opt_copy_control&) = delete;
+    opt_copy_control(opt_copy_control&&) = default;
+    opt_copy_control& operator=(const opt_copy_control&) = delete;
+    opt_copy_control& operator=(opt_copy_control&&) = default;
+};
+
+template <bool moveable> struct opt_move_control
+{};
+
+template <> struct opt_move_control<false>
+{
+    opt_move_control() = default;
+    opt_move_control(const opt_move_control&) = default;
+    opt_move_control(opt_move_control&&) = delete;
+    opt_move_control& operator=(const opt_move_control&) = default;
+    opt_move_control& operator=(opt_move_control&&) = delete;
+};
+
+template <typename T>
+struct opt_members : opt_assign_layer<T>,
+                     opt_copy_control<std::is_copy_constructible_v<T>>,
+                     opt_move_control<std::is_move_constructible_v<T>>
+{
+    using opt_assign_layer<T>::opt_assign_layer;
+};
+} // namespace zl::detail
@@ -0,0 +1,301 @@
+#pragma once
+// Compile-time instruction set selection for the vectorized routines in
+// stdmem.h. Exposes a single byte vector type, detail::simd::vec, backed by
+// the widest instruction set the translation unit is compiled for. Define
+// ZIGLIKE_NO_SIMD to fall back to the wide-word and scalar paths.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if !defined(ZIGLIKE_NO_SIMD)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ZIGLIKE_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ZIGLIKE_SIMD_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define ZIGLIKE_SIMD_NEON
+#endif
+#endif
+
+#if defined(ZIGLIKE_SIMD_AVX2) || defined(ZIGLIKE_SIMD_SSE2) ||                \
+    defined(ZIGLIKE_SIMD_NEON)
+#define ZIGLIKE_SIMD
+#endif
+
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || \
+    defined(_WIN32)
+#define ZIGLIKE_LITTLE_ENDIAN
+#endif
+
+// true when evaluated inside of a constant expression, so that constexpr
+// functions can avoid intrinsics and reinterpret_casts. This needs C++20 or
+// GCC or clang, which is signalled by ZIGLIKE_HAS_CONSTANT_EVALUATED. Without
+// it, constexpr stdmem functions which otherwise use vector instructions or
+// memcpy still compile, but cannot be used in constant expressions.
+#if defined(__cpp_lib_is_constant_evaluated)
+#include <type_traits>
+#define ZIGLIKE_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#define ZIGLIKE_HAS_CONSTANT_EVALUATED
+#elif defined(__GNUC__) || defined(__clang__)
+#define ZIGLIKE_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#define ZIGLIKE_HAS_CONSTANT_EVALUATED
+#else
+#define ZIGLIKE_IS_CONSTANT_EVALUATED() false
+#endif
+
+namespace zl::detail {
+/// Index of the lowest set bit. mask must not be zero.
+inline unsigned lowest_bit(uint64_t mask) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return unsigned(__builtin_ctzll(mask));
+#else
+    unsigned index = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+/// Index of the highest set bit. mask must not be zero.
+inline unsigned highest_bit(uint64_t mask) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - unsigned(__builtin_clzll(mask));
+#else
+    unsigned index = 63;
+    while ((mask & (uint64_t(1) << 63)) == 0) {
+        mask <<= 1;
+        --index;
+    }
+    return index;
+#endif
+}
+
+inline unsigned count_bits(uint64_t mask) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return unsigned(__builtin_popcountll(mask));
+#else
+    unsigned count = 0;
+    for (; mask != 0; mask &= mask - 1)
+        ++count;
+    return count;
+#endif
+}
+
+/// Load a machine word from possibly unaligned memory.
+inline uint64_t load_word(const uint8_t* bytes) noexcept
+{
+    uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+} // namespace zl::detail
+
+#ifdef ZIGLIKE_SIMD
+namespace zl::detail::simd {
+/// A register full of bytes. Comparisons produce a lane-wise 0xFF / 0x00
+/// vector, and mask() packs that into an integer with mask_stride bits per
+/// lane, lowest lane in the lowest bits.
+struct vec
+{
+#if defined(ZIGLIKE_SIMD_AVX2)
+    using native = __m256i;
+    static constexpr size_t width = 32;
+    static constexpr unsigned mask_stride = 1;
+#elif defined(ZIGLIKE_SIMD_SSE2)
+    using native = __m128i;
+    static constexpr size_t width = 16;
+    static constexpr unsigned mask_stride = 1;
+#elif defined(ZIGLIKE_SIMD_NEON)
+    using native = uint8x16_t;
+    static constexpr size_t width = 16;
+    // neon has no movemask, narrowing gives a nibble per lane instead
+    static constexpr unsigned mask_stride = 4;
+#endif
+
+    native v;
+
+    static inline vec load(const uint8_t* bytes) noexcept
+    {
+#if defined(ZIGLIKE_SIMD_AVX2)
+        return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes))};
+#elif defined(ZIGLIKE_SIMD_SSE2)
+        return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes))};
+#elif defined(ZIGLIKE_SIMD_NEON)
+        return {vld1q_u8(bytes)};
+#endif
+    }
+
+    /// bytes must be aligned to width
+    static inline vec load_aligned(const uint8_t* bytes) noexcept
+    {
+#if defined(ZIGLIKE_SIMD_AVX2)
+        return {_mm256_load_si256(reinterpret_cast<const __m256i*>(bytes))};
+#elif defined(ZIGLIKE_SIMD_SSE2)
+        return {_mm_load_si128(reinterpret_cast<const __m128i*>(bytes))};
+#elif defined(ZIGLIKE_SIMD_NEON)
+        return {vld1q_u8(bytes)};
+#endif
+    }
+
+    inline void store(uint8_t* bytes) const noexcept
+    {
+#if defined(ZIGLIKE_SIMD_AVX2)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(bytes), v);
+#elif defined(ZIGLIKE_SIMD_SSE2)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes), v);
+#elif defined(ZIGLIKE_SIMD_NEON)
+        vst1q_u8(bytes, v);
+#endif
+    }
+
+    /// bytes must be aligned to width
+    inline void store_aligned(uint8_t* bytes) const noexcept
+    {
+#if defined(ZIGLIKE_SIMD_AVX2)
+        _mm256_store_si256(reinterpret_cast<__m256i*>(bytes), v);
+#elif defined(ZIGLIKE_SIMD_SSE2)
+        _mm_store_si128(reinterpret_cast<__m128i*>(bytes), v);
+#elif defined(ZIGLIKE_SIMD_NEON)
+        vst1q_u8(bytes, v);
+#endif
+    }
+
+    /// Non-temporal store which bypasses the cache where the instruction set
+    /// supports it. bytes must be aligned to width. Call stream_fence() after
+    /// the last one.
+    inline void stream(uint8_t* bytes) const noexcept
+    {
+#if defined(ZIGLIKE_SIMD_AVX2)
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(bytes), v);
+#elif defined(ZIGLIKE_SIMD_SSE2)
+        _mm_stream_si128(reinterpret_cast<__m128i*>(bytes), v);
+#elif defined(ZIGLIKE_SIMD_NEON)
+        vst1q_u8(bytes, v);
+#endif
+    }
+
+    /// Order previous non-temporal stores before any following stores.
+    static inline void stream_fence() noexcept
+    {
+#if defined(ZIGLIKE_SIMD_AVX2) || defined(ZIGLIKE_SIMD_SSE2)
+        _mm_sfence();
+#endif
+    }
+
+    static inline vec splat(uint8_t byte) noexcept
+    {
+#if defined(ZIGLIKE_SIMD_AVX2)
+        return {_mm256_set1_epi8(char(byte))};
+#elif defined(ZIGLIKE_SIMD_SSE2)
+        return {_mm_set1_epi8(char(byte))};
+#elif defined(ZIGLIKE_SIMD_NEON)
+        return {vdupq_n_u8(byte)};
+#endif
+    }
+
+    inline friend vec operator==(vec a, vec b) noexcept
+    {
+#if defined(ZIGLIKE_SIMD_AVX2)
+        return {_mm256_cmpeq_epi8(a.v, b.v)};
+#elif defined(ZIGLIKE_SIMD_SSE2)
+        return {_mm_cmpeq_epi8(a.v, b.v)};
+#elif defined(ZIGLIKE_SIMD_NEON)
+        return {vceqq_u8(a.v, b.v)};
+#endif
+    }
+
+    /// Compare lanes of Lane bytes, where Lane is 1, 2, 4, or 8. Every byte of
+    /// a lane is 0xFF if the whole lane is equal.
+    template <size_t Lane>
+    static inline vec lanes_equal(vec a, vec b) noexcept
+    {
+        static_assert(Lane == 1 || Lane == 2 || Lane == 4 || Lane == 8,
+                      "Unsupported vector lane width");
+        if constexpr (Lane == 1) {
+            return a == b;
+        }
+#if defined(ZIGLIKE_SIMD_AVX2)
+        else if constexpr (Lane == 2) {
+            return {_mm256_cmpeq_epi16(a.v, b.v)};
+        } else if constexpr (Lane == 4) {
+            return {_mm256_cmpeq_epi32(a.v, b.v)};
+        } else {
+            return {_mm256_cmpeq_epi64(a.v, b.v)};
+        }
+#elif defined(ZIGLIKE_SIMD_SSE2)
+        else if constexpr (Lane == 2) {
+            return {_mm_cmpeq_epi16(a.v, b.v)};
+        } else if constexpr (Lane == 4) {
+            return {_mm_cmpeq_epi32(a.v, b.v)};
+        } else {
+            // no 64 bit compare before sse4.1, both halves have to be equal
+            const __m128i halves = _mm_cmpeq_epi32(a.v, b.v);
+            return {_mm_and_si128(
+                halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)))};
+        }
+#elif defined(ZIGLIKE_SIMD_NEON)
+        else if constexpr (Lane == 2) {
+            return {vreinterpretq_u8_u16(vceqq_u16(vreinterpretq_u16_u8(a.v),
+                                                   vreinterpretq_u16_u8(b.v)))};
+        } else if constexpr (Lane == 4) {
+            return {vreinterpretq_u8_u32(vceqq_u32(vreinterpretq_u32_u8(a.v),
+                                                   vreinterpretq_u32_u8(b.v)))};
+        } else {
+            return {vreinterpretq_u8_u64(vceqq_u64(vreinterpretq_u64_u8(a.v),
+                                                   vreinterpretq_u64_u8(b.v)))};
+        }
+#endif
+    }
+
+    inline friend vec operator&(vec a, vec b) noexcept
+    {
+#if defined(ZIGLIKE_SIMD_AVX2)
+        return {_mm256_and_si256(a.v, b.v)};
+#elif defined(ZIGLIKE_SIMD_SSE2)
+        return {_mm_and_si128(a.v, b.v)};
+#elif defined(ZIGLIKE_SIMD_NEON)
+        return {vandq_u8(a.v, b.v)};
+#endif
+    }
+
+    inline friend vec operator|(vec a, vec b) noexcept
+    {
+#if defined(ZIGLIKE_SIMD_AVX2)
+        return {_mm256_or_si256(a.v, b.v)};
+#elif defined(ZIGLIKE_SIMD_SSE2)
+        return {_mm_or_si128(a.v, b.v)};
+#elif defined(ZIGLIKE_SIMD_NEON)
+        return {vorrq_u8(a.v, b.v)};
+#endif
+    }
+
+    /// Pack the high bit of every lane into an integer.
+    [[nodiscard]] inline uint64_t mask() const noexcept
+    {
+#if defined(ZIGLIKE_SIMD_AVX2)
+        return uint32_t(_mm256_movemask_epi8(v));
+#elif defined(ZIGLIKE_SIMD_SSE2)
+        return uint32_t(_mm_movemask_epi8(v));
+#elif defined(ZIGLIKE_SIMD_NEON)
+        const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(v), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+#endif
+    }
+
+    /// Mask value when every lane is set.
+    static constexpr uint64_t full_mask =
+        width * mask_stride == 64 ? ~uint64_t(0)
+                                  : (uint64_t(1) << (width * mask_stride)) - 1;
+};
+} // namespace zl::detail::simd
+#endif
@@ -0,0 +1,200 @@
+#pragma once
+#include "ziglike/detail/abort.h"
+#include "ziglike/detail/bounds_check.h"
+#include "ziglike/slice.h"
+#include <array>
+
+#ifndef ZIGLIKE_NOEXCEPT
+#define ZIGLIKE_NOEXCEPT noexcept
+#endif
+
+namespace zl {
+namespace detail {
+struct raw_fixed_slice_t
+{};
+} // namespace detail
+
+/// A slice whose size N is known at compile time, like std::span<T, N>. It is
+/// the size of a pointer, converts implicitly to slice<T>, and loops over it
+/// have a constant trip count which the compiler can fully unroll.
+template <typename T, size_t N> class fixed_slice
+{
+  private:
+    T* m_data;
+
+    using TNonConst = std::remove_const_t<T>;
+
+    inline constexpr fixed_slice(detail::raw_fixed_slice_t,
+                                 T* data) ZIGLIKE_NOEXCEPT
+        : m_data(data)
+    {
+    }
+
+    template <typename, size_t> friend class fixed_slice;
+    template <size_t M, typename U>
+    friend constexpr fixed_slice<U, M>
+    raw_fixed_slice(U& data) ZIGLIKE_NOEXCEPT;
+
+  public:
+    using type = T;
+    using value_type = T;
+
+    static constexpr size_t extent = N;
+
+    /// Reference every item of a C array
+    template <typename U,
+              typename = std::enable_if_t<std::is_same_v<U, T> ||
+                                          std::is_same_v<const U, T>>>
+    inline constexpr fixed_slice(U (&array)[N]) ZIGLIKE_NOEXCEPT
+        : m_data(array)
+    {
+    }
+
+    /// Reference every item of a std::array
+    template <typename U,
+              typename = std::enable_if_t<std::is_same_v<U, TNonConst>>>
+    inline constexpr fixed_slice(std::array<U, N>& array) ZIGLIKE_NOEXCEPT
+        : m_data(array.data())
+    {
+    }
+
+    template <typename MaybeT = T,
+              typename = std::enable_if_t<std::is_const_v<MaybeT>>>
+    inline constexpr fixed_slice(const std::array<TNonConst, N>& array)
+        ZIGLIKE_NOEXCEPT : m_data(array.data())
+    {
+    }
+
+    /// A fixed slice of const items can always be made from a nonconst one
+    template <typename U,
+              typename = std::enable_if_t<std::is_const_v<T> &&
+                                          std::is_same_v<U, TNonConst>>>
+    inline constexpr fixed_slice(const fixed_slice<U, N>& other)
+        ZIGLIKE_NOEXCEPT : m_data(other.m_data)
+    {
+    }
+
+    /// Reference the items of a runtime sized slice. Aborts if its size is
+    /// not N.
+    inline constexpr explicit fixed_slice(slice<T> other) ZIGLIKE_NOEXCEPT
+        : m_data(other.data())
+    {
+        if (other.size() != N) [[unlikely]]
+            ZIGLIKE_ABORT();
+    }
+
+    fixed_slice() = delete;
+
+    /// Convert to a runtime sized slice of T or const T.
+    template <typename U,
+              typename = std::enable_if_t<std::is_same_v<U, T> ||
+                                          std::is_same_v<U, const T>>>
+    inline constexpr operator slice<U>() const ZIGLIKE_NOEXCEPT
+    {
+        return raw_slice<U>(*m_data, N);
+    }
+
+    [[nodiscard]] inline constexpr T* data() const ZIGLIKE_NOEXCEPT
+    {
+        return m_data;
+    }
+    [[nodiscard]] static inline constexpr size_t size() ZIGLIKE_NOEXCEPT
+    {
+        return N;
+    }
+
+    /// Access the item at index. Bounds checked according to
+    /// ZIGLIKE_BOUNDS_CHECK, like slice::operator[].
+    [[nodiscard]] inline constexpr T&
+    operator[](size_t index) const ZIGLIKE_NOEXCEPT
+    {
+#ifdef ZIGLIKE_BOUNDS_CHECKED
+        if (index >= N) [[unlikely]]
+            ZIGLIKE_ABORT();
+#endif
+        return m_data[index];
+    }
+
+    /// Access the item at index, or null if index is out of bounds.
+    template <typename U = T>
+    [[nodiscard]] inline constexpr opt<U&>
+    at(size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        if (index >= N)
+            return {};
+        return m_data[index];
+    }
+
+    /// Access the item at index without ever checking bounds.
+    [[nodiscard]] inline constexpr T&
+    unchecked_at(size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        return m_data[index];
+    }
+
+    /// The items from index From (inclusive) to index To (exclusive)
+    template <size_t From, size_t To>
+    [[nodiscard]] inline constexpr fixed_slice<T, To - From>
+    subslice() const ZIGLIKE_NOEXCEPT
+    {
+        static_assert(From <= To && To <= N, "Subslice out of range");
+        return fixed_slice<T, To - From>(detail::raw_fixed_slice_t{},
+                                         m_data + From);
+    }
+
+    /// The first M items
+    template <size_t M>
+    [[nodiscard]] inline constexpr fixed_slice<T, M>
+    first() const ZIGLIKE_NOEXCEPT
+    {
+        static_assert(M <= N, "Subslice out of range");
+        return fixed_slice<T, M>(detail::raw_fixed_slice_t{}, m_data);
+    }
+
+    /// The last M items
+    template <size_t M>
+    [[nodiscard]] inline constexpr fixed_slice<T, M>
+    last() const ZIGLIKE_NOEXCEPT
+    {
+        static_assert(M <= N, "Subslice out of range");
+        return fixed_slice<T, M>(detail::raw_fixed_slice_t{},
+                                 m_data + (N - M));
+    }
+
+    inline constexpr friend bool
+    operator==(const fixed_slice& a, const fixed_slice& b) ZIGLIKE_NOEXCEPT
+    {
+        return a.m_data == b.m_data;
+    }
+
+    inline constexpr friend bool
+    operator!=(const fixed_slice& a, const fixed_slice& b) ZIGLIKE_NOEXCEPT
+    {
+        return a.m_data != b.m_data;
+    }
+
+#ifndef ZIGLIKE_SLICE_NO_ITERATOR
+    using iterator = typename slice<T>::iterator;
+    using const_iterator = typename slice<T>::const_iterator;
+
+    inline constexpr iterator begin() const ZIGLIKE_NOEXCEPT
+    {
+        return iterator(m_data);
+    }
+    inline constexpr iterator end() const ZIGLIKE_NOEXCEPT
+    {
+        return iterator(m_data + N);
+    }
+#endif
+};
+
+/// Construct a fixed slice of N items starting at data. Like raw_slice, this is
+/// the memory-unsafe way of making one.
+template <size_t N, typename T>
+[[nodiscard]] constexpr inline fixed_slice<T, N>
+raw_fixed_slice(T& data) ZIGLIKE_NOEXCEPT
+{
+    return fixed_slice<T, N>(detail::raw_fixed_slice_t{},
+                             std::addressof(data));
+}
+} // namespace zl
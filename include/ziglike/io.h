@@ -0,0 +1,269 @@
+#pragma once
+// Scatter/gather I/O on POSIX file descriptors. Not included by ziglike.h,
+// since it pulls in platform headers.
+
+#if !__has_include(<sys/uio.h>)
+#error "ziglike/io.h requires a POSIX system with <sys/uio.h>"
+#endif
+#ifdef ZIGLIKE_SLICE_NO_ITERATOR
+#error "ziglike/io.h requires joined_slice"
+#endif
+
+#include "ziglike/joined_slice.h"
+#include "ziglike/res.h"
+#include "ziglike/slice.h"
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#ifndef ZIGLIKE_NOEXCEPT
+#define ZIGLIKE_NOEXCEPT noexcept
+#endif
+
+namespace zl {
+/// Errors returned by the functions in io.h, translated from errno.
+enum class io_error : uint8_t
+{
+    Okay,
+    ResultReleased,
+    /// The file descriptor is nonblocking and the operation would block.
+    WouldBlock,
+    /// The other end of a pipe or socket was closed.
+    BrokenPipe,
+    ConnectionReset,
+    NoSpaceLeft,
+    /// Writing would exceed the file size or disk quota limits.
+    FileTooBig,
+    InputOutput,
+    BadFileDescriptor,
+    AccessDenied,
+    /// The file descriptor is a pipe, socket or FIFO, and cannot be used with
+    /// an offset.
+    Unseekable,
+    IsDir,
+    InvalidArgument,
+    /// The system returned no progress where it should have made some, or an
+    /// errno which is not listed here.
+    Unexpected,
+};
+
+/// Write every byte of every slice in buffers to fd, in order, without copying
+/// them into a contiguous buffer. Slices are passed to writev in batches of up
+/// to IOV_MAX, and partial writes are continued until everything is written.
+/// Calls interrupted by signals are retried. Returns the number of bytes
+/// written, which is the size of buffers unless a call failed after some bytes
+/// were already written, for example because a nonblocking fd is full. The
+/// error is only returned if nothing was written.
+[[nodiscard]] inline res<size_t, io_error>
+writev(int fd, joined_slice<const uint8_t> buffers) ZIGLIKE_NOEXCEPT;
+
+/// Read from fd into the slices in buffers, in order, with readv. Returns
+/// after the buffers are full, or after a read which returns fewer bytes than
+/// requested, for example at the end of a file or when a pipe has no more data
+/// available yet. Returns the number of bytes read, zero meaning end of file.
+/// If buffers has more than IOV_MAX segments, later batches are only read if
+/// fd is nonblocking or a regular file, so that a blocking pipe or socket does
+/// not wait for more data once the first batch is full. An error after some
+/// bytes were read, like WouldBlock, is dropped and the bytes are returned.
+[[nodiscard]] inline res<size_t, io_error>
+readv(int fd, joined_slice<uint8_t> buffers) ZIGLIKE_NOEXCEPT;
+
+/// Identical to readv, except that it reads from the given offset into fd with
+/// preadv, and does not change the file offset. Every batch is always read.
+[[nodiscard]] inline res<size_t, io_error>
+preadv(int fd, joined_slice<uint8_t> buffers, off_t offset) ZIGLIKE_NOEXCEPT;
+
+namespace detail {
+#if defined(IOV_MAX)
+inline constexpr size_t iov_batch = IOV_MAX;
+#elif defined(UIO_MAXIOV)
+inline constexpr size_t iov_batch = UIO_MAXIOV;
+#else
+inline constexpr size_t iov_batch = 1024;
+#endif
+
+[[nodiscard]] inline io_error io_error_from_errno(int error) ZIGLIKE_NOEXCEPT
+{
+    switch (error) {
+    case EAGAIN:
+#if EWOULDBLOCK != EAGAIN
+    case EWOULDBLOCK:
+#endif
+        return io_error::WouldBlock;
+    case EPIPE:
+        return io_error::BrokenPipe;
+    case ECONNRESET:
+        return io_error::ConnectionReset;
+    case ENOSPC:
+        return io_error::NoSpaceLeft;
+    case EFBIG:
+#ifdef EDQUOT
+    case EDQUOT:
+#endif
+        return io_error::FileTooBig;
+    case EIO:
+        return io_error::InputOutput;
+    case EBADF:
+        return io_error::BadFileDescriptor;
+    case EACCES:
+    case EPERM:
+        return io_error::AccessDenied;
+    case ESPIPE:
+        return io_error::Unseekable;
+    case EISDIR:
+        return io_error::IsDir;
+    case EINVAL:
+        return io_error::InvalidArgument;
+    default:
+        return io_error::Unexpected;
+    }
+}
+
+/// Position in the segments of a joined slice, which fills batches of iovecs
+/// and advances past the bytes the system call transferred.
+template <typename T> struct iov_cursor
+{
+    slice<const slice<T>> segments;
+    size_t segment = 0;
+    size_t offset = 0;
+
+    /// Fill iovecs with up to iov_batch non-empty segments, starting at the
+    /// current position. Returns the number of iovecs filled, and adds the
+    /// number of bytes they reference to bytes.
+    inline int fill(iovec* iovecs, size_t& bytes) const ZIGLIKE_NOEXCEPT
+    {
+        size_t count = 0;
+        size_t skip = offset;
+        for (size_t i = segment; i < segments.size() && count < iov_batch;
+             ++i) {
+            const slice<T>& current = segments.data()[i];
+            const size_t size = current.size() - skip;
+            if (size != 0) {
+                iovecs[count].iov_base =
+                    const_cast<uint8_t*>(current.data() + skip);
+                iovecs[count].iov_len = size;
+                bytes += size;
+                ++count;
+            }
+            skip = 0;
+        }
+        return int(count);
+    }
+
+    /// Move forward by transferred bytes.
+    inline void advance(size_t transferred) ZIGLIKE_NOEXCEPT
+    {
+        while (transferred != 0) {
+            const size_t remaining = segments.data()[segment].size() - offset;
+            if (transferred < remaining) {
+                offset += transferred;
+                return;
+            }
+            transferred -= remaining;
+            ++segment;
+            offset = 0;
+        }
+    }
+};
+
+/// Whether reading fd again after a full batch cannot wait for more data: it
+/// is nonblocking, or a regular file or block device, which never block.
+[[nodiscard]] inline bool read_never_waits(int fd) ZIGLIKE_NOEXCEPT
+{
+    const int flags = ::fcntl(fd, F_GETFL);
+    if (flags != -1 && (flags & O_NONBLOCK) != 0)
+        return true;
+    struct stat info;
+    return ::fstat(fd, &info) == 0 &&
+           (S_ISREG(info.st_mode) || S_ISBLK(info.st_mode));
+}
+
+/// Shared loop of readv and preadv. read_batch performs one system call with
+/// the given iovecs and the number of bytes read so far. If single_batch is
+/// true, returns after the first batch which reads anything.
+template <typename ReadBatch>
+inline res<size_t, io_error>
+read_segments(joined_slice<uint8_t> buffers, bool single_batch,
+              ReadBatch&& read_batch) ZIGLIKE_NOEXCEPT
+{
+    iovec iovecs[iov_batch];
+    iov_cursor<uint8_t> cursor{buffers.segments()};
+    size_t total = 0;
+    while (true) {
+        size_t requested = 0;
+        const int count = cursor.fill(iovecs, requested);
+        if (count == 0)
+            return size_t(total);
+        const ssize_t result = read_batch(iovecs, count, total);
+        if (result < 0) {
+            if (errno == EINTR)
+                continue;
+            if (total != 0)
+                return size_t(total);
+            return io_error_from_errno(errno);
+        }
+        total += size_t(result);
+        if (size_t(result) < requested || single_batch)
+            return size_t(total);
+        cursor.advance(size_t(result));
+    }
+}
+} // namespace detail
+
+inline res<size_t, io_error>
+writev(int fd, joined_slice<const uint8_t> buffers) ZIGLIKE_NOEXCEPT
+{
+    iovec iovecs[detail::iov_batch];
+    detail::iov_cursor<const uint8_t> cursor{buffers.segments()};
+    size_t total = 0;
+    while (true) {
+        size_t requested = 0;
+        const int count = cursor.fill(iovecs, requested);
+        if (count == 0)
+            return size_t(total);
+        const ssize_t result = ::writev(fd, iovecs, count);
+        if (result < 0) {
+            if (errno == EINTR)
+                continue;
+            if (total != 0)
+                return size_t(total);
+            return detail::io_error_from_errno(errno);
+        }
+        // writev only returns zero for an empty request
+        if (result == 0) [[unlikely]] {
+            if (total != 0)
+                return size_t(total);
+            return io_error::Unexpected;
+        }
+        total += size_t(result);
+        cursor.advance(size_t(result));
+    }
+}
+
+inline res<size_t, io_error>
+readv(int fd, joined_slice<uint8_t> buffers) ZIGLIKE_NOEXCEPT
+{
+    // only check the fd when there is more than one batch to read
+    const bool single_batch = buffers.segments().size() > detail::iov_batch &&
+                              !detail::read_never_waits(fd);
+    return detail::read_segments(
+        buffers, single_batch, [fd](const iovec* iovecs, int count, size_t) {
+            return ::readv(fd, iovecs, count);
+        });
+}
+
+inline res<size_t, io_error> preadv(int fd, joined_slice<uint8_t> buffers,
+                                    off_t offset) ZIGLIKE_NOEXCEPT
+{
+    return detail::read_segments(
+        buffers, false,
+        [fd, offset](const iovec* iovecs, int count, size_t done) {
+            return ::preadv(fd, iovecs, count, offset + off_t(done));
+        });
+}
+} // namespace zl
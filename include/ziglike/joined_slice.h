@@ -9,10 +9,14 @@
 #endif
 
 #include "ziglike/detail/abort.h"
+#include "ziglike/detail/bounds_check.h"
 #include "ziglike/detail/isinstance.h"
+#include "ziglike/opt.h"
 #include "ziglike/slice.h"
 
 namespace zl {
+template <typename T> class indexed_joined_slice;
+
 template <typename T> class joined_slice
 {
   private:
@@ -82,18 +86,26 @@ template <typename T> class joined_slice
     }
 
     /// A joined slice can always be constructed from a nonconst variant of
-    /// itself
-    inline constexpr joined_slice(joined_slice<TNonConst> other)
-        ZIGLIKE_NOEXCEPT : m_slices(other.m_slices)
-    {
-    }
-
-    template <typename U>
-    inline constexpr joined_slice(
-        U other, std::enable_if_t<std::is_same_v<U, joined_slice<TConst>> &&
-                                      std::is_const_v<T>,
-                                  uninstantiable> = {}) ZIGLIKE_NOEXCEPT
+    /// itself. There is no array of slice<T> to point to, so the other's array
+    /// of slice<TNonConst> is viewed as one in place. This is type punning,
+    /// relying on the two having the same layout, which is checked below as
+    /// far as the language allows. It is therefore not constexpr.
+    template <typename U,
+              typename = std::enable_if_t<std::is_const_v<T> &&
+                                          std::is_same_v<U, TNonConst>>>
+    inline joined_slice(const joined_slice<U>& other) ZIGLIKE_NOEXCEPT
+        : m_slices(raw_slice(
+              *reinterpret_cast<const slice<T>*>(other.m_slices.data()),
+              other.m_slices.size()))
     {
+        static_assert(std::is_standard_layout_v<slice<T>> &&
+                          std::is_standard_layout_v<slice<TNonConst>>,
+                      "slice must be standard layout to view a const joined "
+                      "slice through a nonconst one.");
+        static_assert(sizeof(slice<T>) == sizeof(slice<TNonConst>) &&
+                          alignof(slice<T>) == alignof(slice<TNonConst>),
+                      "slice<T> and slice<const T> must have the same size "
+                      "and alignment.");
     }
 
     joined_slice& operator=(const joined_slice&) = default;
@@ -111,6 +123,46 @@ template <typename T> class joined_slice
         return a.m_slices != b.m_slices;
     };
 
+    /// The underlying slices, in order. Loops over each of them are over
+    /// contiguous memory and can be vectorized, unlike loops over the items of
+    /// the joined slice, which branch on every item.
+    [[nodiscard]] inline constexpr slice<const slice<T>>
+    segments() const ZIGLIKE_NOEXCEPT
+    {
+        return m_slices;
+    }
+
+    /// Call function with each underlying slice<T>, in order, skipping empty
+    /// ones.
+    template <typename Function>
+    inline constexpr void
+    for_each_segment(Function&& function) const ZIGLIKE_NOEXCEPT
+    {
+        for (size_t i = 0; i < m_slices.size(); ++i) {
+            if (m_slices.data()[i].size() != 0)
+                function(m_slices.data()[i]);
+        }
+    }
+
+    /// Total number of items in all of the underlying slices. O(segments).
+    [[nodiscard]] inline constexpr size_t size() const ZIGLIKE_NOEXCEPT
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < m_slices.size(); ++i)
+            total += m_slices.data()[i].size();
+        return total;
+    }
+
+    /// Build a prefix sum of segment sizes into offsets, which must have room
+    /// for segments().size() + 1 items, and return a view which uses it for
+    /// O(log segments) indexing. Aborts if offsets is the wrong size. The
+    /// index is invalid once any of the underlying slices change size.
+    [[nodiscard]] inline constexpr indexed_joined_slice<T>
+    build_index(slice<size_t> offsets) const ZIGLIKE_NOEXCEPT;
+
+    /// Forward iterator over every item of every underlying slice. It caches
+    /// the slice it is currently in, so incrementing only touches the slice
+    /// of slices when moving on to the next one.
     struct iterator
     {
         using iterator_category = std::forward_iterator_tag;
@@ -122,9 +174,8 @@ template <typename T> class joined_slice
         inline constexpr pointer ptr() const ZIGLIKE_NOEXCEPT
         {
             assert(m_slice_index < m_slices.size());
-            assert(m_item_index < m_slices.data()[m_slice_index].size());
-            return std::addressof(
-                m_slices.data()[m_slice_index].data()[m_item_index]);
+            assert(m_item_index < m_segment_size);
+            return m_segment + m_item_index;
         }
 
         inline constexpr iterator(slice<const slice<T>> slices,
@@ -135,6 +186,7 @@ template <typename T> class joined_slice
             case Iterpoint::Begin:
                 m_slice_index = 0;
                 m_item_index = 0;
+                skip_empty_segments();
                 break;
             case Iterpoint::End:
                 m_slice_index = slices.size();
@@ -160,9 +212,10 @@ template <typename T> class joined_slice
             if (m_slices.size() == 0) [[unlikely]]
                 std::abort();
             ++m_item_index;
-            if (m_slices.data()[m_slice_index].size() <= m_item_index) {
+            if (m_item_index >= m_segment_size) {
                 ++m_slice_index;
                 m_item_index = 0;
+                skip_empty_segments();
             }
             return *this;
         }
@@ -176,27 +229,177 @@ template <typename T> class joined_slice
             return tmp;
         }
 
+        /// Only compares positions, iterators from different joined slices
+        /// should not be compared.
         inline constexpr friend bool
         operator==(const iterator& a, const iterator& b) ZIGLIKE_NOEXCEPT
         {
-            return a.m_slices == b.m_slices &&
-                   a.m_slice_index == b.m_slice_index &&
+            return a.m_slice_index == b.m_slice_index &&
                    a.m_item_index == b.m_item_index;
         };
 
         inline constexpr friend bool
         operator!=(const iterator& a, const iterator& b) ZIGLIKE_NOEXCEPT
         {
-            return a.m_slices != b.m_slices ||
-                   a.m_slice_index != b.m_slice_index ||
+            return a.m_slice_index != b.m_slice_index ||
                    a.m_item_index != b.m_item_index;
         };
 
       private:
+        /// Move forward from m_slice_index to the first non-empty slice, and
+        /// cache it.
+        inline constexpr void skip_empty_segments() ZIGLIKE_NOEXCEPT
+        {
+            while (m_slice_index < m_slices.size() &&
+                   m_slices.data()[m_slice_index].size() == 0) {
+                ++m_slice_index;
+            }
+            if (m_slice_index < m_slices.size()) {
+                m_segment = m_slices.data()[m_slice_index].data();
+                m_segment_size = m_slices.data()[m_slice_index].size();
+            }
+        }
+
         size_t m_slice_index;
         size_t m_item_index;
+        pointer m_segment = nullptr;
+        size_t m_segment_size = 0;
         slice<const slice<T>> m_slices;
     };
+
+  private:
+    template <typename> friend class joined_slice;
 };
+
+/// A joined slice plus a prefix sum of the sizes of its segments, for random
+/// access in O(log segments). Made by joined_slice::build_index. Does not own
+/// the offsets, which must outlive it.
+template <typename T> class indexed_joined_slice
+{
+  private:
+    joined_slice<T> m_joined;
+    /// m_offsets[i] is the number of items before segment i, and the last
+    /// item is the total number of items.
+    slice<const size_t> m_offsets;
+
+    /// Index of the segment which contains item index, which must be less
+    /// than size(). Empty segments are never returned.
+    [[nodiscard]] inline constexpr size_t
+    segment_of(size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        // find the last offset which is less than or equal to index
+        size_t low = 0;
+        size_t high = m_offsets.size() - 1;
+        while (high - low > 1) {
+            const size_t middle = low + (high - low) / 2;
+            if (m_offsets.data()[middle] <= index)
+                low = middle;
+            else
+                high = middle;
+        }
+        return low;
+    }
+
+    [[nodiscard]] inline constexpr T&
+    item(size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        const size_t segment = segment_of(index);
+        return m_joined.segments().data()[segment].data()
+            [index - m_offsets.data()[segment]];
+    }
+
+  public:
+    using type = T;
+    using value_type = T;
+
+    inline constexpr indexed_joined_slice(
+        joined_slice<T> joined, slice<const size_t> offsets) ZIGLIKE_NOEXCEPT
+        : m_joined(joined),
+          m_offsets(offsets)
+    {
+        if (offsets.size() != joined.segments().size() + 1) [[unlikely]]
+            ZIGLIKE_ABORT();
+    }
+
+    [[nodiscard]] inline constexpr joined_slice<T>
+    joined() const ZIGLIKE_NOEXCEPT
+    {
+        return m_joined;
+    }
+
+    [[nodiscard]] inline constexpr slice<const slice<T>>
+    segments() const ZIGLIKE_NOEXCEPT
+    {
+        return m_joined.segments();
+    }
+
+    /// Total number of items. O(1).
+    [[nodiscard]] inline constexpr size_t size() const ZIGLIKE_NOEXCEPT
+    {
+        return m_offsets.data()[m_offsets.size() - 1];
+    }
+
+    /// Access the item at index. Bounds checked according to
+    /// ZIGLIKE_BOUNDS_CHECK, like slice::operator[].
+    [[nodiscard]] inline constexpr T&
+    operator[](size_t index) const ZIGLIKE_NOEXCEPT
+    {
+#ifdef ZIGLIKE_BOUNDS_CHECKED
+        if (index >= size()) [[unlikely]]
+            ZIGLIKE_ABORT();
+#endif
+        return item(index);
+    }
+
+    /// Access the item at index, or null if index is out of bounds.
+    template <typename U = T>
+    [[nodiscard]] inline constexpr opt<U&>
+    at(size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        if (index >= size())
+            return {};
+        return item(index);
+    }
+
+    /// Access the item at index without ever checking bounds.
+    [[nodiscard]] inline constexpr T&
+    unchecked_at(size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        return item(index);
+    }
+
+    template <typename Function>
+    inline constexpr void
+    for_each_segment(Function&& function) const ZIGLIKE_NOEXCEPT
+    {
+        m_joined.for_each_segment(std::forward<Function>(function));
+    }
+
+    inline constexpr typename joined_slice<T>::iterator
+    begin() const ZIGLIKE_NOEXCEPT
+    {
+        return m_joined.begin();
+    }
+    inline constexpr typename joined_slice<T>::iterator
+    end() const ZIGLIKE_NOEXCEPT
+    {
+        return m_joined.end();
+    }
+};
+
+template <typename T>
+inline constexpr indexed_joined_slice<T>
+joined_slice<T>::build_index(slice<size_t> offsets) const ZIGLIKE_NOEXCEPT
+{
+    if (offsets.size() != m_slices.size() + 1) [[unlikely]]
+        ZIGLIKE_ABORT();
+    size_t total = 0;
+    for (size_t i = 0; i < m_slices.size(); ++i) {
+        offsets.data()[i] = total;
+        total += m_slices.data()[i].size();
+    }
+    offsets.data()[m_slices.size()] = total;
+    return indexed_joined_slice<T>(*this, offsets);
+}
 } // namespace zl
 #endif
@@ -0,0 +1,648 @@
+#pragma once
+#include "ziglike/detail/abort.h"
+#include "ziglike/detail/bounds_check.h"
+#include "ziglike/opt.h"
+#include "ziglike/slice.h"
+#include <array>
+#include <tuple>
+#include <utility>
+
+#ifndef ZIGLIKE_SLICE_NO_ITERATOR
+#include <iterator>
+#endif
+
+#ifndef ZIGLIKE_NOEXCEPT
+#define ZIGLIKE_NOEXCEPT noexcept
+#endif
+
+namespace zl {
+/// Marks an extent of an mdslice which is only known at runtime.
+inline constexpr size_t dynamic_extent = size_t(-1);
+
+/// The size of each dimension of an mdslice. Each of Static is either a
+/// compile-time size or dynamic_extent, in which case the size is given at
+/// construction.
+template <size_t... Static> class extents
+{
+  public:
+    static constexpr size_t rank = sizeof...(Static);
+    static constexpr size_t rank_dynamic =
+        ((Static == dynamic_extent ? 1 : 0) + ... + 0);
+
+    static_assert(rank > 0, "extents must have at least one dimension");
+
+    [[nodiscard]] static inline constexpr size_t
+    static_extent(size_t dimension) ZIGLIKE_NOEXCEPT
+    {
+        constexpr size_t sizes[] = {Static...};
+        return sizes[dimension];
+    }
+
+    /// Construct from either the dynamic extents only, in order, or from every
+    /// extent. In the latter case, aborts if a static extent does not match.
+    template <typename... Sizes,
+              typename = std::enable_if_t<
+                  (sizeof...(Sizes) == rank_dynamic ||
+                   sizeof...(Sizes) == rank) &&
+                  (std::is_convertible_v<Sizes, size_t> && ...)>>
+    inline constexpr explicit extents(Sizes... sizes) ZIGLIKE_NOEXCEPT
+    {
+        const size_t values[] = {size_t(sizes)..., 0};
+        size_t next = 0;
+        for (size_t i = 0; i < rank; ++i) {
+            if constexpr (sizeof...(Sizes) == rank_dynamic) {
+                m_extents[i] = static_extent(i) == dynamic_extent
+                                   ? values[next++]
+                                   : static_extent(i);
+            } else {
+                if (static_extent(i) != dynamic_extent &&
+                    static_extent(i) != values[i]) [[unlikely]]
+                    ZIGLIKE_ABORT();
+                m_extents[i] = values[i];
+            }
+        }
+    }
+
+    /// Size of the given dimension. Folds to a constant for static extents.
+    [[nodiscard]] inline constexpr size_t
+    extent(size_t dimension) const ZIGLIKE_NOEXCEPT
+    {
+        return static_extent(dimension) == dynamic_extent
+                   ? m_extents[dimension]
+                   : static_extent(dimension);
+    }
+
+    /// Total number of items, the product of every extent.
+    [[nodiscard]] inline constexpr size_t size() const ZIGLIKE_NOEXCEPT
+    {
+        size_t out = 1;
+        for (size_t i = 0; i < rank; ++i)
+            out *= extent(i);
+        return out;
+    }
+
+    inline constexpr friend bool operator==(const extents& a,
+                                            const extents& b) ZIGLIKE_NOEXCEPT
+    {
+        for (size_t i = 0; i < rank; ++i) {
+            if (a.extent(i) != b.extent(i))
+                return false;
+        }
+        return true;
+    }
+
+    inline constexpr friend bool operator!=(const extents& a,
+                                            const extents& b) ZIGLIKE_NOEXCEPT
+    {
+        return !(a == b);
+    }
+
+  private:
+    size_t m_extents[rank] = {};
+};
+
+namespace detail {
+template <typename Sequence> struct make_dextents;
+template <size_t... I> struct make_dextents<std::index_sequence<I...>>
+{
+    using type = extents<((void)I, dynamic_extent)...>;
+};
+} // namespace detail
+
+/// Extents of the given rank which are all dynamic.
+template <size_t Rank>
+using dextents =
+    typename detail::make_dextents<std::make_index_sequence<Rank>>::type;
+
+/// Layouts map a multidimensional index to an offset into the underlying
+/// slice. Each one has a nested mapping template, instantiated with the
+/// extents type.
+
+/// Row-major (C) layout: the last index is contiguous.
+struct layout_right
+{
+    template <typename Extents> class mapping
+    {
+      public:
+        static constexpr size_t rank = Extents::rank;
+
+        inline constexpr mapping(const Extents& extents) ZIGLIKE_NOEXCEPT
+            : m_extents(extents)
+        {
+        }
+
+        [[nodiscard]] inline constexpr const Extents&
+        extents() const ZIGLIKE_NOEXCEPT
+        {
+            return m_extents;
+        }
+
+        [[nodiscard]] inline constexpr size_t
+        stride(size_t dimension) const ZIGLIKE_NOEXCEPT
+        {
+            size_t out = 1;
+            for (size_t i = dimension + 1; i < rank; ++i)
+                out *= m_extents.extent(i);
+            return out;
+        }
+
+        [[nodiscard]] inline constexpr size_t
+        operator()(const size_t (&index)[rank]) const ZIGLIKE_NOEXCEPT
+        {
+            size_t offset = 0;
+            for (size_t i = 0; i < rank; ++i)
+                offset = (offset * m_extents.extent(i)) + index[i];
+            return offset;
+        }
+
+        [[nodiscard]] inline constexpr size_t
+        required_span_size() const ZIGLIKE_NOEXCEPT
+        {
+            return m_extents.size();
+        }
+
+      private:
+        Extents m_extents;
+    };
+};
+
+/// Column-major (Fortran) layout: the first index is contiguous.
+struct layout_left
+{
+    template <typename Extents> class mapping
+    {
+      public:
+        static constexpr size_t rank = Extents::rank;
+
+        inline constexpr mapping(const Extents& extents) ZIGLIKE_NOEXCEPT
+            : m_extents(extents)
+        {
+        }
+
+        [[nodiscard]] inline constexpr const Extents&
+        extents() const ZIGLIKE_NOEXCEPT
+        {
+            return m_extents;
+        }
+
+        [[nodiscard]] inline constexpr size_t
+        stride(size_t dimension) const ZIGLIKE_NOEXCEPT
+        {
+            size_t out = 1;
+            for (size_t i = 0; i < dimension; ++i)
+                out *= m_extents.extent(i);
+            return out;
+        }
+
+        [[nodiscard]] inline constexpr size_t
+        operator()(const size_t (&index)[rank]) const ZIGLIKE_NOEXCEPT
+        {
+            size_t offset = 0;
+            for (size_t i = rank; i-- > 0;)
+                offset = (offset * m_extents.extent(i)) + index[i];
+            return offset;
+        }
+
+        [[nodiscard]] inline constexpr size_t
+        required_span_size() const ZIGLIKE_NOEXCEPT
+        {
+            return m_extents.size();
+        }
+
+      private:
+        Extents m_extents;
+    };
+};
+
+/// Arbitrary strides per dimension. This is the layout of subviews.
+struct layout_stride
+{
+    template <typename Extents> class mapping
+    {
+      public:
+        static constexpr size_t rank = Extents::rank;
+
+        inline constexpr mapping(const Extents& extents,
+                                 const std::array<size_t, rank>& strides)
+            ZIGLIKE_NOEXCEPT : m_extents(extents),
+                               m_strides(strides)
+        {
+        }
+
+        [[nodiscard]] inline constexpr const Extents&
+        extents() const ZIGLIKE_NOEXCEPT
+        {
+            return m_extents;
+        }
+
+        [[nodiscard]] inline constexpr size_t
+        stride(size_t dimension) const ZIGLIKE_NOEXCEPT
+        {
+            return m_strides[dimension];
+        }
+
+        [[nodiscard]] inline constexpr size_t
+        operator()(const size_t (&index)[rank]) const ZIGLIKE_NOEXCEPT
+        {
+            size_t offset = 0;
+            for (size_t i = 0; i < rank; ++i)
+                offset += index[i] * m_strides[i];
+            return offset;
+        }
+
+        /// One past the offset of the last item.
+        [[nodiscard]] inline constexpr size_t
+        required_span_size() const ZIGLIKE_NOEXCEPT
+        {
+            size_t last = 0;
+            for (size_t i = 0; i < rank; ++i) {
+                if (m_extents.extent(i) == 0)
+                    return 0;
+                last += (m_extents.extent(i) - 1) * m_strides[i];
+            }
+            return last + 1;
+        }
+
+      private:
+        Extents m_extents;
+        std::array<size_t, rank> m_strides;
+    };
+};
+
+/// Two dimensional layout made of TileRows by TileColumns tiles, which are
+/// stored in row-major order and are row-major themselves. Keeps 2D
+/// neighbourhoods within a few cache lines for stencils and transposes. Both
+/// extents must be multiples of the tile size.
+template <size_t TileRows, size_t TileColumns> struct layout_tiled
+{
+    static_assert(TileRows > 0 && TileColumns > 0, "Tiles cannot be empty");
+    static constexpr size_t tile_rows = TileRows;
+    static constexpr size_t tile_columns = TileColumns;
+
+    template <typename Extents> class mapping
+    {
+      public:
+        static constexpr size_t rank = Extents::rank;
+        static_assert(rank == 2, "Only two dimensional mdslices can be tiled");
+
+        inline constexpr mapping(const Extents& extents) ZIGLIKE_NOEXCEPT
+            : m_extents(extents)
+        {
+            if (extents.extent(0) % TileRows != 0 ||
+                extents.extent(1) % TileColumns != 0) [[unlikely]]
+                ZIGLIKE_ABORT();
+        }
+
+        [[nodiscard]] inline constexpr const Extents&
+        extents() const ZIGLIKE_NOEXCEPT
+        {
+            return m_extents;
+        }
+
+        [[nodiscard]] inline constexpr size_t
+        operator()(const size_t (&index)[rank]) const ZIGLIKE_NOEXCEPT
+        {
+            return tile_offset(index[0] / TileRows, index[1] / TileColumns) +
+                   ((index[0] % TileRows) * TileColumns) +
+                   (index[1] % TileColumns);
+        }
+
+        /// Offset of the first item of a tile.
+        [[nodiscard]] inline constexpr size_t
+        tile_offset(size_t tile_row, size_t tile_column) const ZIGLIKE_NOEXCEPT
+        {
+            const size_t tiles_per_row = m_extents.extent(1) / TileColumns;
+            return ((tile_row * tiles_per_row) + tile_column) *
+                   (TileRows * TileColumns);
+        }
+
+        [[nodiscard]] inline constexpr size_t
+        required_span_size() const ZIGLIKE_NOEXCEPT
+        {
+            return m_extents.size();
+        }
+
+      private:
+        Extents m_extents;
+    };
+};
+
+namespace detail {
+template <typename Layout> struct is_tiled : std::false_type
+{};
+template <size_t R, size_t C>
+struct is_tiled<layout_tiled<R, C>> : std::true_type
+{};
+} // namespace detail
+
+/// A non-owning multidimensional view of a contiguously allocated array of
+/// type T. Extents is an instantiation of zl::extents, and Layout decides how
+/// indices map to memory. Like slice, it is never null.
+template <typename T, typename Extents, typename Layout = layout_right>
+class mdslice
+{
+  public:
+    using type = T;
+    using value_type = T;
+    using extents_type = Extents;
+    using layout_type = Layout;
+    using mapping_type = typename Layout::template mapping<Extents>;
+
+    static constexpr size_t rank = Extents::rank;
+
+  private:
+    T* m_data;
+    mapping_type m_mapping;
+
+    inline constexpr mdslice(T* data,
+                             const mapping_type& mapping) ZIGLIKE_NOEXCEPT
+        : m_data(data),
+          m_mapping(mapping)
+    {
+    }
+
+    template <typename, typename, typename> friend class mdslice;
+
+    [[nodiscard]] inline constexpr bool
+    in_bounds(const size_t (&index)[rank]) const ZIGLIKE_NOEXCEPT
+    {
+        for (size_t i = 0; i < rank; ++i) {
+            if (index[i] >= extent(i))
+                return false;
+        }
+        return true;
+    }
+
+  public:
+    /// View data through the given mapping. Aborts if data is too small.
+    inline constexpr mdslice(slice<T> data,
+                             const mapping_type& mapping) ZIGLIKE_NOEXCEPT
+        : m_data(data.data()),
+          m_mapping(mapping)
+    {
+        if (data.size() < m_mapping.required_span_size()) [[unlikely]]
+            ZIGLIKE_ABORT();
+    }
+
+    /// View data with the given extents, passed like the constructor of
+    /// zl::extents: either only the dynamic ones or all of them. Aborts if data
+    /// is too small.
+    template <typename... Sizes,
+              typename = std::enable_if_t<
+                  std::is_constructible_v<mapping_type, Extents> &&
+                  (std::is_convertible_v<Sizes, size_t> && ...)>>
+    inline constexpr mdslice(slice<T> data, Sizes... sizes) ZIGLIKE_NOEXCEPT
+        : mdslice(data, mapping_type(Extents(sizes...)))
+    {
+    }
+
+    /// An mdslice of const items can always be made from a nonconst one
+    template <typename U>
+    inline constexpr mdslice(
+        const mdslice<U, Extents, Layout>& other,
+        std::enable_if_t<std::is_const_v<T> &&
+                             std::is_same_v<U, std::remove_const_t<T>>,
+                         int> = 0) ZIGLIKE_NOEXCEPT
+        : m_data(other.m_data),
+          m_mapping(other.m_mapping)
+    {
+    }
+
+    mdslice() = delete;
+
+    [[nodiscard]] inline constexpr T* data() const ZIGLIKE_NOEXCEPT
+    {
+        return m_data;
+    }
+
+    [[nodiscard]] inline constexpr const mapping_type&
+    mapping() const ZIGLIKE_NOEXCEPT
+    {
+        return m_mapping;
+    }
+
+    [[nodiscard]] inline constexpr const Extents&
+    extents() const ZIGLIKE_NOEXCEPT
+    {
+        return m_mapping.extents();
+    }
+
+    [[nodiscard]] inline constexpr size_t
+    extent(size_t dimension) const ZIGLIKE_NOEXCEPT
+    {
+        return m_mapping.extents().extent(dimension);
+    }
+
+    /// Total number of items.
+    [[nodiscard]] inline constexpr size_t size() const ZIGLIKE_NOEXCEPT
+    {
+        return m_mapping.extents().size();
+    }
+
+    /// Access the item at the given indices, one per dimension. Bounds checked
+    /// according to ZIGLIKE_BOUNDS_CHECK, like slice::operator[].
+    template <typename... Indices>
+    [[nodiscard]] inline constexpr T&
+    operator()(Indices... indices) const ZIGLIKE_NOEXCEPT
+    {
+        static_assert(sizeof...(Indices) == rank,
+                      "Wrong number of indices given to mdslice");
+        const size_t index[rank] = {size_t(indices)...};
+#ifdef ZIGLIKE_BOUNDS_CHECKED
+        if (!in_bounds(index)) [[unlikely]]
+            ZIGLIKE_ABORT();
+#endif
+        return m_data[m_mapping(index)];
+    }
+
+    /// Access the item at the given indices, or null if any is out of bounds.
+    template <typename... Indices>
+    [[nodiscard]] inline constexpr opt<T&>
+    at(Indices... indices) const ZIGLIKE_NOEXCEPT
+    {
+        static_assert(sizeof...(Indices) == rank,
+                      "Wrong number of indices given to mdslice");
+        const size_t index[rank] = {size_t(indices)...};
+        if (!in_bounds(index))
+            return {};
+        return m_data[m_mapping(index)];
+    }
+
+    /// Access the item at the given indices without ever checking bounds.
+    template <typename... Indices>
+    [[nodiscard]] inline constexpr T&
+    unchecked_at(Indices... indices) const ZIGLIKE_NOEXCEPT
+    {
+        static_assert(sizeof...(Indices) == rank,
+                      "Wrong number of indices given to mdslice");
+        const size_t index[rank] = {size_t(indices)...};
+        return m_data[m_mapping(index)];
+    }
+
+    /// A view of the box of the given sizes starting at offsets, in the same
+    /// memory. Aborts if the box does not fit inside this mdslice.
+    [[nodiscard]] inline constexpr mdslice<T, dextents<rank>, layout_stride>
+    subview(const std::array<size_t, rank>& offsets,
+            const std::array<size_t, rank>& sizes) const ZIGLIKE_NOEXCEPT
+    {
+        static_assert(!detail::is_tiled<Layout>::value,
+                      "Subviews of tiled mdslices are not contiguous in any "
+                      "dimension, use tile() instead");
+        size_t index[rank] = {};
+        std::array<size_t, rank> strides = {};
+        bool empty = false;
+        for (size_t i = 0; i < rank; ++i) {
+            if (offsets[i] > extent(i) || sizes[i] > extent(i) - offsets[i])
+                [[unlikely]]
+                ZIGLIKE_ABORT();
+            index[i] = offsets[i];
+            strides[i] = m_mapping.stride(i);
+            empty = empty || sizes[i] == 0;
+        }
+        const auto sub_extents = std::apply(
+            [](auto... all) { return dextents<rank>(all...); }, sizes);
+        return mdslice<T, dextents<rank>, layout_stride>(
+            m_data + (empty ? 0 : m_mapping(index)),
+            typename layout_stride::template mapping<dextents<rank>>(
+                sub_extents, strides));
+    }
+
+    /// The tile at the given tile coordinates of a tiled mdslice, which is
+    /// itself a contiguous row-major mdslice.
+    template <typename L = Layout>
+    [[nodiscard]] inline constexpr mdslice<
+        T, zl::extents<L::tile_rows, L::tile_columns>, layout_right>
+    tile(size_t tile_row, size_t tile_column) const ZIGLIKE_NOEXCEPT
+    {
+        static_assert(detail::is_tiled<L>::value,
+                      "tile() is only available for tiled mdslices");
+        if (tile_row >= extent(0) / L::tile_rows ||
+            tile_column >= extent(1) / L::tile_columns) [[unlikely]]
+            ZIGLIKE_ABORT();
+        using tile_extents = zl::extents<L::tile_rows, L::tile_columns>;
+        return mdslice<T, tile_extents, layout_right>(
+            m_data + m_mapping.tile_offset(tile_row, tile_column),
+            layout_right::mapping<tile_extents>(tile_extents()));
+    }
+
+    /// Every row of the mdslice, meaning every run of items along the last
+    /// dimension, as a contiguous slice. Only available if the last dimension
+    /// has a stride of one, which is always true for row-major mdslices and
+    /// their subviews. Aborts otherwise.
+    class rows_view
+    {
+      public:
+        /// Number of rows, the product of every extent but the last one.
+        [[nodiscard]] inline constexpr size_t size() const ZIGLIKE_NOEXCEPT
+        {
+            size_t out = 1;
+            for (size_t i = 0; i + 1 < rank; ++i)
+                out *= m_parent.extent(i);
+            return out;
+        }
+
+        [[nodiscard]] inline constexpr slice<T>
+        operator[](size_t row) const ZIGLIKE_NOEXCEPT
+        {
+            const size_t length = m_parent.extent(rank - 1);
+            size_t offset = 0;
+            if constexpr (std::is_same_v<Layout, layout_right>) {
+                offset = row * length;
+            } else {
+                // split the row number into indices of the leading dimensions
+                size_t index[rank] = {};
+                for (size_t i = rank - 1; i-- > 0;) {
+                    index[i] = row % m_parent.extent(i);
+                    row /= m_parent.extent(i);
+                }
+                offset = m_parent.m_mapping(index);
+            }
+            return raw_slice(m_parent.m_data[offset], length);
+        }
+
+#ifndef ZIGLIKE_SLICE_NO_ITERATOR
+        struct iterator
+        {
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = slice<T>;
+            using pointer = void;
+            using reference = slice<T>;
+
+            inline constexpr iterator(const rows_view& rows,
+                                      size_t row) ZIGLIKE_NOEXCEPT
+                : m_rows(rows),
+                  m_row(row)
+            {
+            }
+
+            inline constexpr slice<T> operator*() const ZIGLIKE_NOEXCEPT
+            {
+                return m_rows[m_row];
+            }
+
+            // Prefix increment
+            inline constexpr iterator& operator++() ZIGLIKE_NOEXCEPT
+            {
+                ++m_row;
+                return *this;
+            }
+
+            // Postfix increment
+            // NOLINTNEXTLINE
+            inline constexpr iterator operator++(int) ZIGLIKE_NOEXCEPT
+            {
+                iterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            inline constexpr friend bool
+            operator==(const iterator& a, const iterator& b) ZIGLIKE_NOEXCEPT
+            {
+                return a.m_row == b.m_row;
+            };
+            inline constexpr friend bool
+            operator!=(const iterator& a, const iterator& b) ZIGLIKE_NOEXCEPT
+            {
+                return a.m_row != b.m_row;
+            };
+
+          private:
+            rows_view m_rows;
+            size_t m_row;
+        };
+
+        inline constexpr iterator begin() const ZIGLIKE_NOEXCEPT
+        {
+            return iterator(*this, 0);
+        }
+        inline constexpr iterator end() const ZIGLIKE_NOEXCEPT
+        {
+            return iterator(*this, size());
+        }
+#endif
+
+      private:
+        friend class mdslice;
+        inline constexpr rows_view(const mdslice& parent) ZIGLIKE_NOEXCEPT
+            : m_parent(parent)
+        {
+        }
+
+        mdslice m_parent;
+    };
+
+    [[nodiscard]] inline constexpr rows_view rows() const ZIGLIKE_NOEXCEPT
+    {
+        static_assert(!detail::is_tiled<Layout>::value,
+                      "Rows of tiled mdslices are not contiguous, iterate over "
+                      "tile() instead");
+        if constexpr (!std::is_same_v<Layout, layout_right>) {
+            if (m_mapping.stride(rank - 1) != 1 && size() != 0) [[unlikely]]
+                ZIGLIKE_ABORT();
+        }
+        return rows_view(*this);
+    }
+};
+} // namespace zl
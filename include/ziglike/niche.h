@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+
+namespace zl {
+/// Bit patterns of T which are never valid values, called niches. opt<T>
+/// stores its null state in a niche instead of a separate flag when T has at
+/// least one, and res<T, StatusCode> stores its status codes in niches when T
+/// has at least 256, one for each possible status code. In both cases they
+/// are then exactly the size of T.
+///
+/// Specialize this for types with spare bit patterns, like handles which
+/// reserve their highest values, or indices which are never negative. A
+/// specialization must be for a trivially copyable type and must provide:
+///
+///     // number of niches, which are numbered 0 to count - 1
+///     static constexpr size_t count;
+///     // the value of niche number index, where index < count
+///     static constexpr T make(size_t index) noexcept;
+///     // the number of the niche which item is, or count if item is valid
+///     static constexpr size_t index_of(const T& item) noexcept;
+template <typename T> struct niche
+{
+    static constexpr size_t count = 0;
+};
+
+namespace detail {
+template <typename T, bool = std::is_enum_v<T>> struct niche_integer
+{
+    using type = T;
+};
+template <typename T> struct niche_integer<T, true>
+{
+    using type = std::underlying_type_t<T>;
+};
+} // namespace detail
+
+/// Niches made of the Count highest values of an unsigned integer type, or of
+/// an enum with an unsigned underlying type. For example, a handle declared
+/// as enum class handle : uint32_t {}, whose value is never UINT32_MAX, can be
+/// stored in an opt with no overhead with this specialization:
+///
+///     template <> struct zl::niche<handle> : zl::niche_max_values<handle, 1>
+///     {};
+template <typename T, size_t Count> struct niche_max_values
+{
+  private:
+    using Int = typename detail::niche_integer<T>::type;
+    static constexpr Int max = Int(-1);
+
+  public:
+    static_assert(std::is_unsigned_v<Int> && Count != 0 &&
+                      Count - 1 <= size_t(max),
+                  "niche_max_values requires an unsigned integer or enum "
+                  "type, and a number of niches which it can represent.");
+
+    static constexpr size_t count = Count;
+
+    [[nodiscard]] static inline constexpr T make(size_t index) noexcept
+    {
+        return T(Int(max - Int(index)));
+    }
+
+    [[nodiscard]] static inline constexpr size_t
+    index_of(const T& item) noexcept
+    {
+        const size_t from_top = size_t(Int(max - Int(item)));
+        return from_top < Count ? from_top : Count;
+    }
+};
+} // namespace zl
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "detail/abort.h"
+#include "detail/isinstance.h"
+#include "detail/opt_storage.h"
+#include "niche.h"
 #include <cstdint>
 #include <functional>
+#include <type_traits>
 #include <utility>
 
 #ifdef ZIGLIKE_USE_FMT
@@ -14,7 +18,6 @@
 #endif
 
 #ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-#include "./detail/isinstance.h"
 #include "./slice.h"
 #endif
 
@@ -47,120 +50,146 @@ template <typename T> class opt
     static constexpr bool is_slice = zl::detail::is_instance<T, zl::slice>{};
 #endif
 
-  private:
-    union raw_optional
-    {
-        T some;
-        uint8_t none;
-        inline ~raw_optional() ZIGLIKE_NOEXCEPT {}
-    };
+    /// Whether the null state is stored in a niche of T, see niche.h. This is
+    /// always true for slices, unless ZIGLIKE_NO_SMALL_OPTIONAL_SLICE is
+    /// defined.
+    static constexpr bool is_niche = !is_reference && niche<T>::count != 0;
 
-    struct members
-    {
-        bool has_value = false;
-        raw_optional value{.none = 0};
-    };
+    static_assert(!is_niche || std::is_trivially_copyable_v<T>,
+                  "Optional type has niches, but only trivially copyable types "
+                  "can store their null state in a niche.");
+
+  private:
+    /// Flag and union, with copy, move and destruction only as non-trivial
+    /// as those of T.
+    using members = detail::opt_members<T>;
 
     struct members_ref
     {
         std::remove_reference_t<T>* pointer = nullptr;
     };
 
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-    struct members_slice
+    /// T itself, which is null when it holds niche number zero.
+    struct members_niche
     {
-        size_t elements;
-        // propagate const-ness of slice
-        std::conditional_t<std::is_const_v<typename T::type>,
-                           const typename T::type*, typename T::type*>
-            data = nullptr;
+        T some = niche<T>::make(0);
     };
 
     using members_t = std::conditional_t<
         is_reference, members_ref,
-        std::conditional_t<is_slice, members_slice, members>>;
-#else
-    using members_t =
-        typename std::conditional<is_reference, members_ref, members>::type;
-#endif
+        std::conditional_t<is_niche, members_niche, members>>;
 
     members_t m;
 
+    /// Members holding a T constructed from args. Constructors initialize m
+    /// with this directly, which works in constant expressions since C++17.
+    template <typename... Args>
+    [[nodiscard]] static inline constexpr members_t
+    make_members(Args&&... args) ZIGLIKE_NOEXCEPT
+    {
+        if constexpr (is_niche) {
+            return members_t{T(std::forward<Args>(args)...)};
+        } else {
+            return members_t(std::in_place, std::forward<Args>(args)...);
+        }
+    }
+
+    /// Replace the contents with a T constructed from args. Trivially copyable
+    /// types are assigned all at once so that this is usable in constant
+    /// expressions before C++20.
+    template <typename... Args>
+    inline constexpr void replace(Args&&... args) ZIGLIKE_NOEXCEPT
+    {
+        if constexpr (std::is_trivially_copyable_v<members_t>) {
+            m = make_members(std::forward<Args>(args)...);
+        } else {
+            m.destroy();
+            m.construct(std::forward<Args>(args)...);
+        }
+    }
+
+    /// The value, without checking that there is one.
+    [[nodiscard]] inline constexpr T& unchecked_value() & ZIGLIKE_NOEXCEPT
+    {
+        if constexpr (is_reference) {
+            return *m.pointer;
+        } else if constexpr (is_niche) {
+            return m.some;
+        } else {
+            return m.value.some;
+        }
+    }
+
+    [[nodiscard]] inline constexpr T&& unchecked_value() && ZIGLIKE_NOEXCEPT
+    {
+        if constexpr (is_reference) {
+            return *m.pointer;
+        } else {
+            return std::move(unchecked_value());
+        }
+    }
+
+    [[nodiscard]] inline constexpr const T&
+    unchecked_value() const& ZIGLIKE_NOEXCEPT
+    {
+        if constexpr (is_reference) {
+            return *m.pointer;
+        } else if constexpr (is_niche) {
+            return m.some;
+        } else {
+            return m.value.some;
+        }
+    }
+
+    /// The type held by the optional returned from transform(). Functions
+    /// which return lvalue references produce optional references, others
+    /// produce optional values.
+    template <typename Result>
+    using transform_t = opt<std::conditional_t<
+        std::is_lvalue_reference_v<Result>, Result,
+        std::remove_cv_t<std::remove_reference_t<Result>>>>;
+
   public:
     /// Returns true if its safe to call value(), false otherwise.
-    [[nodiscard]] inline bool has_value() const ZIGLIKE_NOEXCEPT
+    [[nodiscard]] inline constexpr bool has_value() const ZIGLIKE_NOEXCEPT
     {
         if constexpr (is_reference) {
             return m.pointer != nullptr;
-        } else
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-            if constexpr (is_slice) {
-            return m.data != nullptr;
-        } else
-#endif
-        {
+        } else if constexpr (is_niche) {
+            return niche<T>::index_of(m.some) == niche<T>::count;
+        } else {
             return m.has_value;
         }
     }
 
     /// Extract the inner value of the optional, or abort the program. Check
     /// has_value() before calling this.
-    [[nodiscard]] inline T& value() & ZIGLIKE_NOEXCEPT
+    [[nodiscard]] inline constexpr T& value() & ZIGLIKE_NOEXCEPT
     {
         if (!has_value()) [[unlikely]] {
             ZIGLIKE_ABORT();
         }
-        if constexpr (is_reference) {
-            return *m.pointer;
-        } else
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-            if constexpr (is_slice) {
-            return *reinterpret_cast<T*>(&m);
-        } else
-#endif
-        {
-            return std::ref(m.value.some);
-        }
+        return unchecked_value();
     }
 
-    [[nodiscard]] inline T&& value() && ZIGLIKE_NOEXCEPT
+    [[nodiscard]] inline constexpr T&& value() && ZIGLIKE_NOEXCEPT
     {
         if (!has_value()) [[unlikely]] {
             ZIGLIKE_ABORT();
         }
-        if constexpr (is_reference) {
-            return *m.pointer;
-        } else
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-            if constexpr (is_slice) {
-            return std::move(*reinterpret_cast<T*>(&m));
-        } else
-#endif
-        {
-            return std::move(m.value.some);
-        }
+        return std::move(*this).unchecked_value();
     }
 
-    inline const T& value() const& ZIGLIKE_NOEXCEPT
+    inline constexpr const T& value() const& ZIGLIKE_NOEXCEPT
     {
         if (!has_value()) [[unlikely]] {
             ZIGLIKE_ABORT();
         }
-        if constexpr (is_reference) {
-            return *m.pointer;
-        } else
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-            if constexpr (is_slice) {
-            return *reinterpret_cast<const T*>(&m);
-        } else
-#endif
-        {
-            return std::ref(m.value.some);
-        }
+        return unchecked_value();
     }
 
     /// Call destructor of internal type, or just reset it if it doesnt have one
-    inline void reset() ZIGLIKE_NOEXCEPT
+    inline constexpr void reset() ZIGLIKE_NOEXCEPT
     {
         if (!has_value()) [[unlikely]] {
             return;
@@ -168,62 +197,26 @@ template <typename T> class opt
 
         if constexpr (is_reference) {
             m.pointer = nullptr;
-        } else
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-            if constexpr (is_slice) {
-            m.data = nullptr;
-            m.elements = 0;
-        } else
-#endif
-        {
-            m.value.some.~T();
-            m.has_value = false;
+        } else if constexpr (is_niche) {
+            m.some = niche<T>::make(0);
+        } else {
+            m.destroy();
         }
     }
 
     /// Types can be constructed directly in to the optional
     template <typename... Args>
-    inline void emplace(Args&&... args) ZIGLIKE_NOEXCEPT
+    inline constexpr void emplace(Args&&... args) ZIGLIKE_NOEXCEPT
     {
         static_assert(
             !is_reference,
             "Reference types cannot be emplaced, assign them instead.");
         static_assert(std::is_constructible_v<T, decltype(args)...>,
                       "Type T is not constructible with given arguments");
-        if (has_value()) [[unlikely]] {
-            reset();
-        }
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-        if constexpr (is_slice) {
-            T* slicelocation = reinterpret_cast<T*>(&m);
-            new (slicelocation) T(args...);
-        } else {
-#endif
-            new (&m.value.some) T(std::forward<decltype(args)>(args)...);
-            m.has_value = true;
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-        }
-#endif
+        replace(std::forward<Args>(args)...);
     }
 
     inline constexpr opt() ZIGLIKE_NOEXCEPT {}
-    inline ~opt() ZIGLIKE_NOEXCEPT
-    {
-        if constexpr (is_reference) {
-            m.pointer = nullptr;
-        } else
-
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-            if constexpr (is_slice) {
-            m.data = nullptr;
-            m.elements = 0;
-        } else
-#endif
-        {
-            reset();
-            m.has_value = false;
-        }
-    }
 
     /// Able to assign a moved type if the type is moveable
     template <typename MaybeT = T>
@@ -238,11 +231,7 @@ template <typename T> class opt
         static_assert(std::is_nothrow_constructible_v<MaybeT, MaybeT&&>,
                       "Attempt to move type into an opt, but the move "
                       "constructor of the type can throw an exception.");
-        if (m.has_value) {
-            m.value.some.~MaybeT();
-        }
-        new (&m.value.some) MaybeT(std::move(something));
-        m.has_value = true;
+        replace(std::move(something));
         return *this;
     }
 
@@ -254,12 +243,11 @@ template <typename T> class opt
 #endif
                                       std::is_constructible_v<MaybeT, MaybeT&&>,
                                   MaybeT>&& something) ZIGLIKE_NOEXCEPT
+        : m(make_members(std::move(something)))
     {
         static_assert(std::is_nothrow_constructible_v<MaybeT, MaybeT&&>,
                       "Attempt to move type into an opt, but the move "
                       "constructor of the type can throw an exception.");
-        new (&m.value.some) MaybeT(std::move(something));
-        m.has_value = true;
     }
 
     /// Copyable types can also be assigned into their optionals
@@ -273,22 +261,8 @@ template <typename T> class opt
                    std::is_constructible_v<MaybeT, const MaybeT&>),
               MaybeT>& something) ZIGLIKE_NOEXCEPT
     {
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-        if constexpr (is_slice) {
-            m.data = something.data();
-            m.elements = something.size();
-            return *this;
-        } else {
-#endif
-            if (m.has_value) {
-                m.value.some.~MaybeT();
-            }
-            new (&m.value.some) MaybeT(something);
-            m.has_value = true;
-            return *this;
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-        }
-#endif
+        replace(something);
+        return *this;
     }
 
     // copy constructor
@@ -300,18 +274,8 @@ template <typename T> class opt
                              (!is_reference &&
                               std::is_constructible_v<MaybeT, const MaybeT&>),
                          MaybeT>& something) ZIGLIKE_NOEXCEPT
+        : m(make_members(something))
     {
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-        if constexpr (is_slice) {
-            m.data = something.data();
-            m.elements = something.size();
-        } else {
-#endif
-            new (std::addressof(m.value.some)) T(something);
-            m.has_value = true;
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-        }
-#endif
     }
 
     template <typename... Args>
@@ -324,12 +288,11 @@ template <typename T> class opt
                              std::is_constructible_v<T, Args...>),
                          std::in_place_t>,
         Args&&... args) ZIGLIKE_NOEXCEPT
+        : m(make_members(std::forward<Args>(args)...))
     {
         static_assert(std::is_nothrow_constructible_v<T, Args...>,
                       "Attempt to construct item in-place in optional but the "
                       "constructor invoked can throw exceptions.");
-        new (std::addressof(m.value.some)) T(std::forward<Args>(args)...);
-        m.has_value = true;
     }
 
     /// Optional containing a reference type can be directly constructed from
@@ -337,8 +300,8 @@ template <typename T> class opt
     template <typename MaybeT = T>
     inline constexpr opt(typename std::enable_if_t<is_reference, MaybeT>
                              something) ZIGLIKE_NOEXCEPT
+        : m{std::addressof(something)}
     {
-        m.pointer = std::addressof(something);
     }
 
     /// Reference types can be assigned to an optional to overwrite it.
@@ -347,11 +310,14 @@ template <typename T> class opt
     operator=(typename std::enable_if_t<is_reference, MaybeT> something)
         ZIGLIKE_NOEXCEPT
     {
-        m.pointer = &something;
+        m.pointer = std::addressof(something);
         return *this;
     }
 
-    inline constexpr explicit operator bool() noexcept { return has_value(); }
+    inline constexpr explicit operator bool() const noexcept
+    {
+        return has_value();
+    }
 
     /// NOTE: References are not able to use the == overload because
     /// it would not be clear whether it was a strict comparison or not. (ie is
@@ -371,20 +337,14 @@ template <typename T> class opt
         if (!self.has_value()) {
             return !other.has_value();
         } else {
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-            if constexpr (is_slice) {
-                return !other.has_value()
-                           ? false
-                           : *reinterpret_cast<const T*>(&self.m) ==
-                                 *reinterpret_cast<const T*>(&other.m);
+            if constexpr (is_niche) {
+                return !other.has_value() ? false
+                                          : self.m.some == other.m.some;
             } else {
-#endif
                 return !other.has_value()
                            ? false
                            : self.m.value.some == other.m.value.some;
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
             }
-#endif
         }
     }
 
@@ -398,15 +358,11 @@ template <typename T> class opt
                    (!is_reference && std::is_same_v<MaybeT, T>),
                MaybeT>& other) const ZIGLIKE_NOEXCEPT
     {
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-        if constexpr (is_slice) {
-            return !has_value() ? false : *reinterpret_cast<T*>(&m) == other;
+        if constexpr (is_niche) {
+            return !has_value() ? false : m.some == other;
         } else {
-#endif
             return !has_value() ? false : m.value.some == other;
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
         }
-#endif
     }
 
     /// NOT EQUALS: Compare an optional to another optional of the same type
@@ -423,19 +379,14 @@ template <typename T> class opt
         if (!self.has_value()) {
             return other.has_value();
         } else {
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-            if constexpr (is_slice) {
+            if constexpr (is_niche) {
                 return !other.has_value() ? true
-                                          : *reinterpret_cast<T*>(&self.m) !=
-                                                *reinterpret_cast<T*>(&other.m);
+                                          : self.m.some != other.m.some;
             } else {
-#endif
                 return !other.has_value()
                            ? true
                            : self.m.value.some != other.m.value.some;
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
             }
-#endif
         }
     }
 
@@ -449,15 +400,11 @@ template <typename T> class opt
                    (!is_reference && std::is_same_v<MaybeT, T>),
                MaybeT>& other) const ZIGLIKE_NOEXCEPT
     {
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-        if constexpr (is_slice) {
-            return !has_value() ? true : *reinterpret_cast<T*>(&m) != other;
+        if constexpr (is_niche) {
+            return !has_value() ? true : m.some != other;
         } else {
-#endif
             return !has_value() ? true : m.value.some != other;
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
         }
-#endif
     }
 
     // Strict comparison for an optional reference: return true if the optional
@@ -487,6 +434,124 @@ template <typename T> class opt
         return other == *m.pointer;
     }
 
+    /// Return a copy of the value, or fallback converted to T if this is null.
+    /// For optional references, fallback must be an lvalue which the returned
+    /// reference can refer to.
+    template <typename U>
+    [[nodiscard]] inline constexpr T
+    value_or(U&& fallback) const& ZIGLIKE_NOEXCEPT
+    {
+        return has_value() ? unchecked_value()
+                           : static_cast<T>(std::forward<U>(fallback));
+    }
+
+    /// Move the value out, or return fallback converted to T if this is null.
+    template <typename U>
+    [[nodiscard]] inline constexpr T value_or(U&& fallback) && ZIGLIKE_NOEXCEPT
+    {
+        return has_value() ? std::move(*this).unchecked_value()
+                           : static_cast<T>(std::forward<U>(fallback));
+    }
+
+    /// If this has a value, return an opt of f(value), otherwise null. f is
+    /// passed the value with the same reference qualification as this, so
+    /// calling transform on an rvalue moves the value into f. If f returns an
+    /// lvalue reference, the result is an optional reference.
+    template <typename Callable>
+    [[nodiscard]] inline constexpr transform_t<
+        std::invoke_result_t<Callable, T&>>
+    transform(Callable&& f) & ZIGLIKE_NOEXCEPT
+    {
+        if (!has_value())
+            return {};
+        return std::forward<Callable>(f)(unchecked_value());
+    }
+
+    template <typename Callable>
+    [[nodiscard]] inline constexpr transform_t<
+        std::invoke_result_t<Callable, const T&>>
+    transform(Callable&& f) const& ZIGLIKE_NOEXCEPT
+    {
+        if (!has_value())
+            return {};
+        return std::forward<Callable>(f)(unchecked_value());
+    }
+
+    template <typename Callable>
+    [[nodiscard]] inline constexpr transform_t<
+        std::invoke_result_t<Callable, T&&>>
+    transform(Callable&& f) && ZIGLIKE_NOEXCEPT
+    {
+        if (!has_value())
+            return {};
+        return std::forward<Callable>(f)(std::move(*this).unchecked_value());
+    }
+
+    /// If this has a value, return f(value), which must return an opt,
+    /// otherwise null. Like transform, the value is passed to f with the same
+    /// reference qualification as this.
+    template <typename Callable>
+    [[nodiscard]] inline constexpr std::invoke_result_t<Callable, T&>
+    and_then(Callable&& f) & ZIGLIKE_NOEXCEPT
+    {
+        using result = std::invoke_result_t<Callable, T&>;
+        static_assert(detail::is_instance<std::remove_cv_t<result>, opt>{},
+                      "Function passed to and_then must return an opt.");
+        if (!has_value())
+            return result{};
+        return std::forward<Callable>(f)(unchecked_value());
+    }
+
+    template <typename Callable>
+    [[nodiscard]] inline constexpr std::invoke_result_t<Callable, const T&>
+    and_then(Callable&& f) const& ZIGLIKE_NOEXCEPT
+    {
+        using result = std::invoke_result_t<Callable, const T&>;
+        static_assert(detail::is_instance<std::remove_cv_t<result>, opt>{},
+                      "Function passed to and_then must return an opt.");
+        if (!has_value())
+            return result{};
+        return std::forward<Callable>(f)(unchecked_value());
+    }
+
+    template <typename Callable>
+    [[nodiscard]] inline constexpr std::invoke_result_t<Callable, T&&>
+    and_then(Callable&& f) && ZIGLIKE_NOEXCEPT
+    {
+        using result = std::invoke_result_t<Callable, T&&>;
+        static_assert(detail::is_instance<std::remove_cv_t<result>, opt>{},
+                      "Function passed to and_then must return an opt.");
+        if (!has_value())
+            return result{};
+        return std::forward<Callable>(f)(std::move(*this).unchecked_value());
+    }
+
+    /// Return a copy of this if it has a value, otherwise f(), which must
+    /// return an opt of the same type.
+    template <typename Callable>
+    [[nodiscard]] inline constexpr opt
+    or_else(Callable&& f) const& ZIGLIKE_NOEXCEPT
+    {
+        static_assert(std::is_same_v<std::invoke_result_t<Callable>, opt>,
+                      "Function passed to or_else must return an opt of the "
+                      "same type.");
+        if (has_value())
+            return *this;
+        return std::forward<Callable>(f)();
+    }
+
+    /// Move this into the result if it has a value, otherwise return f().
+    template <typename Callable>
+    [[nodiscard]] inline constexpr opt or_else(Callable&& f) && ZIGLIKE_NOEXCEPT
+    {
+        static_assert(std::is_same_v<std::invoke_result_t<Callable>, opt>,
+                      "Function passed to or_else must return an opt of the "
+                      "same type.");
+        if (has_value())
+            return std::move(*this);
+        return std::forward<Callable>(f)();
+    }
+
 #ifdef ZIGLIKE_USE_FMT
     friend struct fmt::formatter<opt>;
 #endif
@@ -519,14 +584,9 @@ template <typename T> struct fmt::formatter<zl::opt<T>>
         if (optional.has_value()) {
             if constexpr (zl::opt<T>::is_reference) {
                 return fmt::format_to(ctx.out(), "{}", *optional.m.pointer);
-            } else
-#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
-                if constexpr (zl::opt<T>::is_slice) {
-                return fmt::format_to(ctx.out(), "{}",
-                                      *reinterpret_cast<const T*>(&optional.m));
-            } else
-#endif
-            {
+            } else if constexpr (zl::opt<T>::is_niche) {
+                return fmt::format_to(ctx.out(), "{}", optional.m.some);
+            } else {
                 return fmt::format_to(ctx.out(), "{}", optional.m.value.some);
             }
         }
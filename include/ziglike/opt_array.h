@@ -0,0 +1,177 @@
+#pragma once
+#include "ziglike/detail/abort.h"
+#include "ziglike/detail/bounds_check.h"
+#include "ziglike/detail/simd.h"
+#include "ziglike/opt.h"
+#include "ziglike/slice.h"
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#ifndef ZIGLIKE_NOEXCEPT
+#define ZIGLIKE_NOEXCEPT noexcept
+#endif
+
+namespace zl {
+/// A fixed size array of N optional items, stored as a bitmap of which items
+/// are present followed by the items themselves. Unlike an array of opt<T>,
+/// there is no flag and padding per item, and the items are contiguous so they
+/// can be scanned with vector instructions regardless of which are present.
+///
+/// Items which are not present still occupy their slot, whose contents are
+/// unspecified, so T must be trivially copyable and default constructible.
+template <typename T, size_t N> class opt_array
+{
+  public:
+    static_assert(std::is_trivially_copyable_v<T> &&
+                      std::is_default_constructible_v<T> &&
+                      !std::is_const_v<T>,
+                  "opt_array items must be non-const, trivially copyable and "
+                  "default constructible.");
+    static_assert(N != 0, "Attempt to create an empty opt_array.");
+
+    using type = T;
+    using value_type = T;
+    using word = uint64_t;
+
+    /// Number of bits in each word of the bitmap.
+    static constexpr size_t word_bits = sizeof(word) * 8;
+    /// Number of words in the bitmap.
+    static constexpr size_t words = (N + word_bits - 1) / word_bits;
+
+  private:
+    word m_presence[words] = {};
+    T m_items[N];
+
+    [[nodiscard]] static inline constexpr word
+    bit_of(size_t index) ZIGLIKE_NOEXCEPT
+    {
+        return word(1) << (index % word_bits);
+    }
+
+    inline constexpr void check_index(size_t index) const ZIGLIKE_NOEXCEPT
+    {
+#ifdef ZIGLIKE_BOUNDS_CHECKED
+        if (index >= N) [[unlikely]]
+            ZIGLIKE_ABORT();
+#endif
+    }
+
+  public:
+    /// Every item starts out not present.
+    inline constexpr opt_array() ZIGLIKE_NOEXCEPT : m_items() {}
+
+    [[nodiscard]] static inline constexpr size_t size() ZIGLIKE_NOEXCEPT
+    {
+        return N;
+    }
+
+    /// Returns true if the item at index is present. Bounds checked according
+    /// to ZIGLIKE_BOUNDS_CHECK, like slice::operator[].
+    [[nodiscard]] inline constexpr bool
+    has_value(size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        check_index(index);
+        return (m_presence[index / word_bits] & bit_of(index)) != 0;
+    }
+
+    /// The item at index, or null if it is not present. Bounds checked
+    /// according to ZIGLIKE_BOUNDS_CHECK, like slice::operator[].
+    [[nodiscard]] inline constexpr opt<T&>
+    operator[](size_t index) ZIGLIKE_NOEXCEPT
+    {
+        if (!has_value(index))
+            return {};
+        return m_items[index];
+    }
+
+    [[nodiscard]] inline constexpr opt<const T&>
+    operator[](size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        if (!has_value(index))
+            return {};
+        return m_items[index];
+    }
+
+    /// Construct an item at index from args, and mark it present.
+    template <typename... Args>
+    inline constexpr T& emplace(size_t index, Args&&... args) ZIGLIKE_NOEXCEPT
+    {
+        static_assert(std::is_constructible_v<T, Args...>,
+                      "Type T is not constructible with given arguments");
+        check_index(index);
+        m_items[index] = T(std::forward<Args>(args)...);
+        m_presence[index / word_bits] |= bit_of(index);
+        return m_items[index];
+    }
+
+    /// Mark the item at index as not present.
+    inline constexpr void reset(size_t index) ZIGLIKE_NOEXCEPT
+    {
+        check_index(index);
+        m_presence[index / word_bits] &= ~bit_of(index);
+    }
+
+    /// Mark every item as not present.
+    inline constexpr void reset() ZIGLIKE_NOEXCEPT
+    {
+        for (word& bits : m_presence)
+            bits = 0;
+    }
+
+    /// Number of items which are present.
+    [[nodiscard]] inline size_t count() const ZIGLIKE_NOEXCEPT
+    {
+        size_t total = 0;
+        for (const word bits : m_presence)
+            total += detail::count_bits(bits);
+        return total;
+    }
+
+    /// Call f(index, item) for every item which is present, in order of
+    /// index. Skips 64 slots at a time where none are present, and otherwise
+    /// only visits set bits of the bitmap.
+    template <typename Callable>
+    inline void for_each(Callable&& f) ZIGLIKE_NOEXCEPT
+    {
+        for (size_t i = 0; i < words; ++i) {
+            for (word bits = m_presence[i]; bits != 0; bits &= bits - 1) {
+                const size_t index = i * word_bits + detail::lowest_bit(bits);
+                f(index, m_items[index]);
+            }
+        }
+    }
+
+    template <typename Callable>
+    inline void for_each(Callable&& f) const ZIGLIKE_NOEXCEPT
+    {
+        for (size_t i = 0; i < words; ++i) {
+            for (word bits = m_presence[i]; bits != 0; bits &= bits - 1) {
+                const size_t index = i * word_bits + detail::lowest_bit(bits);
+                f(index, static_cast<const T&>(m_items[index]));
+            }
+        }
+    }
+
+    /// Every slot, including those which are not present. Use with
+    /// presence() to process items in bulk, for example comparing every slot
+    /// with vector instructions and then masking out the result.
+    [[nodiscard]] inline constexpr slice<T> items() ZIGLIKE_NOEXCEPT
+    {
+        return raw_slice(m_items[0], N);
+    }
+
+    [[nodiscard]] inline constexpr slice<const T> items() const ZIGLIKE_NOEXCEPT
+    {
+        return raw_slice(m_items[0], N);
+    }
+
+    /// The bitmap, where bit i % 64 of word i / 64 is set if item i is
+    /// present. Bits past N in the last word are always zero.
+    [[nodiscard]] inline constexpr slice<const word>
+    presence() const ZIGLIKE_NOEXCEPT
+    {
+        return raw_slice(m_presence[0], words);
+    }
+};
+} // namespace zl
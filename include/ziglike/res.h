@@ -1,6 +1,8 @@
 #pragma once
 
 #include "detail/abort.h"
+#include "detail/opt_storage.h"
+#include "niche.h"
 #include <cstdint>
 #include <type_traits>
 #include <utility> // std::in_place_t
@@ -14,6 +16,80 @@
 #endif
 
 namespace zl {
+namespace detail {
+/// Status code and union of a res. Only has a destructor if the payload does,
+/// so that results of trivial types are literal types which can be made in
+/// constant expressions.
+template <typename T, typename StatusCode,
+          bool = std::is_trivially_destructible_v<T>>
+struct res_storage
+{
+    StatusCode status;
+    opt_union<T> value;
+
+    inline constexpr explicit res_storage(StatusCode failure) ZIGLIKE_NOEXCEPT
+        : status(failure)
+    {
+    }
+
+    template <typename... Args>
+    inline constexpr explicit res_storage(std::in_place_t,
+                                          Args&&... args) ZIGLIKE_NOEXCEPT
+        : status(StatusCode::Okay),
+          value(std::in_place, std::forward<Args>(args)...)
+    {
+    }
+};
+
+template <typename T, typename StatusCode>
+struct res_storage<T, StatusCode, false>
+{
+    StatusCode status;
+    opt_union<T> value;
+
+    inline constexpr explicit res_storage(StatusCode failure) ZIGLIKE_NOEXCEPT
+        : status(failure)
+    {
+    }
+
+    template <typename... Args>
+    inline constexpr explicit res_storage(std::in_place_t,
+                                          Args&&... args) ZIGLIKE_NOEXCEPT
+        : status(StatusCode::Okay),
+          value(std::in_place, std::forward<Args>(args)...)
+    {
+    }
+
+    inline ZIGLIKE_CONSTEXPR_DESTRUCTOR ~res_storage() ZIGLIKE_NOEXCEPT
+    {
+        if (status == StatusCode::Okay)
+            value.some.~T();
+    }
+};
+
+/// Payload of a res whose status codes are stored in its niches, see niche.h.
+/// Niche number N is the status code whose value, as an unsigned byte, is N.
+template <typename T, typename StatusCode> struct res_niche_storage
+{
+    using code_bits = std::make_unsigned_t<std::underlying_type_t<StatusCode>>;
+
+    T value;
+
+    inline constexpr explicit res_niche_storage(StatusCode failure)
+        ZIGLIKE_NOEXCEPT
+        : value(niche<T>::make(size_t(code_bits(failure))))
+    {
+    }
+
+    template <typename... Args>
+    inline constexpr explicit res_niche_storage(std::in_place_t,
+                                                Args&&... args)
+        ZIGLIKE_NOEXCEPT : value(std::forward<Args>(args)...)
+    {
+    }
+};
+} // namespace detail
+
 /// A result which is either a type T or a status code about why failure
 /// occurred. StatusCode must be an 8-bit enum with an entry called "Okay"
 /// equal to 0, and another entry called ResultReleased.
@@ -51,20 +127,52 @@ template <typename T, typename StatusCode> class res
 
     static constexpr bool is_reference = std::is_lvalue_reference_v<T>;
 
-    union raw_optional
+    /// Whether status codes are stored in niches of T, which requires one
+    /// niche for every value a StatusCode can have.
+    static constexpr bool is_niche =
+        !is_reference && niche<T>::count >= (size_t(1) << 8);
+
+    static_assert(!is_niche || std::is_trivially_copyable_v<T>,
+                  "Result type has niches, but only trivially copyable types "
+                  "can store status codes in their niches.");
+
+    using payload_t = std::conditional_t<is_reference, wrapper, T>;
+
+    using members =
+        std::conditional_t<is_niche, detail::res_niche_storage<T, StatusCode>,
+                           detail::res_storage<payload_t, StatusCode>>;
+
+    members m;
+
+    [[nodiscard]] inline constexpr payload_t& payload() ZIGLIKE_NOEXCEPT
     {
-        std::conditional_t<is_reference, wrapper, T> some;
-        uint8_t none;
-        ~raw_optional() ZIGLIKE_NOEXCEPT {}
-    };
+        if constexpr (is_niche) {
+            return m.value;
+        } else {
+            return m.value.some;
+        }
+    }
 
-    struct members
+    [[nodiscard]] inline constexpr const payload_t&
+    payload() const ZIGLIKE_NOEXCEPT
     {
-        StatusCode status;
-        raw_optional value{.none = 0};
-    };
+        if constexpr (is_niche) {
+            return m.value;
+        } else {
+            return m.value.some;
+        }
+    }
 
-    members m;
+    /// Make it an error to access the payload again. For niche payloads this
+    /// overwrites them, so copy them out first.
+    inline constexpr void mark_released() ZIGLIKE_NOEXCEPT
+    {
+        if constexpr (is_niche) {
+            m = members(StatusCode::ResultReleased);
+        } else {
+            m.status = StatusCode::ResultReleased;
+        }
+    }
 
   public:
     using type = T;
@@ -73,27 +181,47 @@ template <typename T, typename StatusCode> class res
     /// Returns true if it is safe to call release(), otherwise false.
     [[nodiscard]] inline constexpr bool okay() const ZIGLIKE_NOEXCEPT
     {
-        return m.status == StatusCode::Okay;
+        if constexpr (is_niche) {
+            return niche<T>::index_of(m.value) == niche<T>::count;
+        } else {
+            return m.status == StatusCode::Okay;
+        }
     }
 
     [[nodiscard]] inline constexpr StatusCode err() const ZIGLIKE_NOEXCEPT
     {
-        return m.status;
+        if constexpr (is_niche) {
+            using code_bits = typename members::code_bits;
+            const size_t index = niche<T>::index_of(m.value);
+            return index == niche<T>::count
+                       ? StatusCode::Okay
+                       : StatusCode(std::underlying_type_t<StatusCode>(
+                             code_bits(index)));
+        } else {
+            return m.status;
+        }
     }
 
     /// Return a copy of the internal contents of the result. If this result is
     /// an error, this aborts the program. Check okay() before calling this
-    /// function.
-    [[nodiscard]] inline std::conditional_t<is_reference, T, T&&>
+    /// function. Payloads with niches are returned by value, since releasing
+    /// the result overwrites them.
+    [[nodiscard]] inline constexpr std::conditional_t<is_reference || is_niche,
+                                                      T, T&&>
     release() ZIGLIKE_NOEXCEPT
     {
         if (!okay()) [[unlikely]] {
             ZIGLIKE_ABORT();
         }
-        m.status = StatusCode::ResultReleased;
         if constexpr (is_reference) {
+            mark_released();
             return m.value.some.item;
+        } else if constexpr (is_niche) {
+            const T out = m.value;
+            mark_released();
+            return out;
         } else {
+            mark_released();
             return std::move(m.value.some);
         }
     }
@@ -103,16 +231,23 @@ template <typename T, typename StatusCode> class res
     /// an error, this aborts the program. Check okay() before calling this
     /// function. Do not try to call release() or release_ref() again, after
     /// calling release() or release_ref() once, the result is invalidated.
+    /// Not available for payloads with niches, since invalidating the result
+    /// would overwrite the payload which the reference points to.
     template <typename MaybeT = T>
-        [[nodiscard]] inline typename std::enable_if_t<!is_reference, MaybeT>&
+        [[nodiscard]] inline constexpr typename std::enable_if_t<!is_reference,
+                                                                 MaybeT>&
         release_ref() &
         ZIGLIKE_NOEXCEPT
     {
+        static_assert(!is_niche,
+                      "release_ref() is not available for results which "
+                      "store their status code in niches of the payload, "
+                      "since releasing would overwrite it. Use release().");
         if (!okay()) [[unlikely]] {
             ZIGLIKE_ABORT();
         }
-        m.status = StatusCode::ResultReleased;
-        return m.value.some;
+        mark_released();
+        return payload();
     }
 
     template <typename MaybeT = T, typename... Args>
@@ -120,21 +255,19 @@ template <typename T, typename StatusCode> class res
         std::enable_if_t<!is_reference && std::is_constructible_v<T, Args...>,
                          std::in_place_t>,
         Args&&... args) noexcept
+        : m(std::in_place, std::forward<Args>(args)...)
     {
         static_assert(std::is_nothrow_constructible_v<T, Args...>,
                       "Attempt to construct in place but constructor invoked "
                       "can throw exceptions.");
-        m.status = StatusCode::Okay;
-        new (&m.value.some) T(std::forward<Args>(args)...);
     }
 
     /// if T is a reference type, then you can construct a result from it
     template <typename MaybeT = T>
     inline constexpr res(typename std::enable_if_t<is_reference, MaybeT>
                              success) ZIGLIKE_NOEXCEPT
+        : m(std::in_place, success)
     {
-        m.status = StatusCode::Okay;
-        new (&m.value.some) wrapper(success);
     }
 
     /// Wrapped type can moved into a result
@@ -142,22 +275,19 @@ template <typename T, typename StatusCode> class res
     inline constexpr res(
         typename std::enable_if_t<
             !is_reference && std::is_move_constructible_v<T>, MaybeT>&& success)
-        ZIGLIKE_NOEXCEPT
+        ZIGLIKE_NOEXCEPT : m(std::in_place, std::move(success))
     {
         static_assert(std::is_nothrow_move_constructible_v<T>,
                       "Attempt to use move constructor, but it throws and "
                       "function is marked noexcept.");
-        m.status = StatusCode::Okay;
-        new (&m.value.some) T(std::move(success));
     }
 
     /// A statuscode can also be implicitly converted to a result
-    inline constexpr res(StatusCode failure) ZIGLIKE_NOEXCEPT
+    inline constexpr res(StatusCode failure) ZIGLIKE_NOEXCEPT : m(failure)
     {
         if (failure == StatusCode::Okay) [[unlikely]] {
             ZIGLIKE_ABORT();
         }
-        m.status = failure;
     }
 
     /// Copy constructor only available if the wrapped type is trivially
@@ -168,15 +298,9 @@ template <typename T, typename StatusCode> class res
                                          std::is_trivially_copy_constructible_v<
                                              T>)&&std::is_same_v<ThisType, res>,
                                         ThisType>& other) ZIGLIKE_NOEXCEPT
+        : m(other.okay() ? members(std::in_place, other.payload())
+                         : members(other.err()))
     {
-        if (other.okay()) {
-            if constexpr (is_reference) {
-                m.value.some = other.m.value.some.item;
-            } else {
-                m.value.some = other.m.value.some;
-            }
-        }
-        m.status = other.m.status;
     }
 
     // Result cannot be assigned to, only constructed and then released.
@@ -191,39 +315,17 @@ template <typename T, typename StatusCode> class res
             (is_reference ||
              std::is_move_constructible_v<T>)&&std::is_same_v<ThisType, res>,
             ThisType>&& other) ZIGLIKE_NOEXCEPT
+        : m(other.okay() ? members(std::in_place, std::move(other.payload()))
+                         : members(other.err()))
     {
-        if (other.okay()) {
-            if constexpr (is_reference) {
-                m.value.some.item = other.m.value.some.item;
-            } else {
-                m.value.some = std::move(other.m.value.some);
-            }
-        }
-        m.status = other.m.status;
         // make it an error to access a result after it has been moved into
         // another
-        other.m.status = StatusCode::ResultReleased;
-    }
-
-    inline ~res() ZIGLIKE_NOEXCEPT
-    {
-        if constexpr (!is_reference) {
-            if (okay()) {
-                m.value.some.~T();
-            }
-        }
-        m.status = StatusCode::ResultReleased;
+        other.mark_released();
     }
 
 #ifdef ZIGLIKE_USE_FMT
     friend struct fmt::formatter<res>;
 #endif
-
-  private:
-    inline constexpr explicit res() ZIGLIKE_NOEXCEPT
-    {
-        m.status = StatusCode::Okay;
-    }
 };
 } // namespace zl
 
@@ -249,20 +351,17 @@ struct fmt::formatter<zl::res<T, StatusCode>>
     {
         if (result.okay()) {
             if constexpr (zl::res<T, StatusCode>::is_reference) {
-                return fmt::format_to(ctx.out(), "{}",
-                                      result.m.value.some.item);
+                return fmt::format_to(ctx.out(), "{}", result.payload().item);
             } else {
-                return fmt::format_to(ctx.out(), "{}", result.m.value.some);
+                return fmt::format_to(ctx.out(), "{}", result.payload());
             }
         } else {
-            if constexpr (fmt::is_formattable<
-                              decltype(result.m.status)>::value) {
-                return fmt::format_to(ctx.out(), "err {}", result.m.status);
+            if constexpr (fmt::is_formattable<StatusCode>::value) {
+                return fmt::format_to(ctx.out(), "err {}", result.err());
             } else {
                 return fmt::format_to(
                     ctx.out(), "err {}",
-                    std::underlying_type_t<decltype(result.m.status)>(
-                        result.m.status));
+                    std::underlying_type_t<StatusCode>(result.err()));
             }
         }
     }
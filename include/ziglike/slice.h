@@ -1,13 +1,16 @@
 #pragma once
 #include "ziglike/detail/isinstance.h"
 #include <cassert>
+#include <utility>
 
 #ifndef ZIGLIKE_SLICE_NO_ITERATOR
 #include <iterator>
 #endif
 
 #include "ziglike/detail/abort.h"
+#include "ziglike/detail/bounds_check.h"
 #include "ziglike/detail/is_container.h"
+#include "ziglike/niche.h"
 
 #ifdef ZIGLIKE_USE_FMT
 #include <fmt/core.h>
@@ -21,6 +24,14 @@ namespace zl {
 
 // forward decls
 template <typename T> class slice;
+template <typename T> class opt;
+template <typename T> class slice_chunks;
+template <typename T, size_t N> class slice_fixed_chunks;
+template <typename T, size_t N> class fixed_slice;
+template <size_t N, typename T>
+[[nodiscard]] constexpr inline fixed_slice<T, N>
+raw_fixed_slice(T& data) ZIGLIKE_NOEXCEPT;
+template <typename T> class slice_windows;
 template <typename T>
 [[nodiscard]] constexpr inline slice<T> raw_slice(T& data,
                                                   size_t size) ZIGLIKE_NOEXCEPT;
@@ -36,10 +47,10 @@ template <typename T> class slice
     T* m_data;
 
     inline constexpr slice(T* data, size_t size) ZIGLIKE_NOEXCEPT
+        : m_elements(size),
+          m_data(data)
     {
         assert(data != nullptr);
-        m_data = data;
-        m_elements = size;
     }
 
     using TNonConst = typename std::conditional_t<std::is_const_v<T>,
@@ -51,12 +62,12 @@ template <typename T> class slice
     template <typename U>
     inline constexpr slice(inner_constructor_t,
                            const slice<U>& other) ZIGLIKE_NOEXCEPT
+        : m_elements(other.size()),
+          m_data(const_cast<T*>(other.data()))
     {
         static_assert(std::is_const_v<T> ||
                           (!std::is_const_v<U> && !std::is_const_v<T>),
                       "Instantiated const cast inner constructor incorrectly");
-        m_data = const_cast<T*>(other.data());
-        m_elements = other.size();
     }
 
     struct inner_single_constructor_t
@@ -64,14 +75,25 @@ template <typename T> class slice
     template <typename U = T>
     inline constexpr slice(inner_single_constructor_t,
                            const U& item) ZIGLIKE_NOEXCEPT
+        : m_elements(1),
+          m_data(const_cast<T*>(std::addressof(item)))
     {
         static_assert(
             std::is_const_v<T> || (!std::is_const_v<U> && !std::is_const_v<T>),
             "Instantiated const cast inner single constructor incorrectly");
-        m_data = const_cast<T*>(std::addressof(item));
-        m_elements = 1;
     }
 
+    /// The niche of slice, which is the only way to make a slice whose data is
+    /// nullptr. Lets an opt<slice> store a slice directly and use its data
+    /// pointer as the flag.
+    struct null_t
+    {};
+    inline constexpr explicit slice(null_t) ZIGLIKE_NOEXCEPT : m_elements(0),
+                                                               m_data(nullptr)
+    {
+    }
+    template <typename> friend struct niche;
+
     /// Struct whose only purpose to exist in parameter lists as a way of doing
     /// enable_if...
     struct uninstantiable
@@ -105,8 +127,9 @@ template <typename T> class slice
     using value_type = T;
 
 #ifndef ZIGLIKE_SLICE_NO_ITERATOR
-    struct iterator;
-    struct const_iterator;
+    template <typename U> struct basic_iterator;
+    using iterator = basic_iterator<T>;
+    using const_iterator = basic_iterator<TConst>;
 
     using correct_iterator =
         std::conditional_t<std::is_const_v<T>, const_iterator, iterator>;
@@ -143,6 +166,119 @@ template <typename T> class slice
         return m_elements;
     }
 
+    /// Access the item at index. Aborts if index is out of bounds, unless
+    /// bounds checking is disabled by ZIGLIKE_BOUNDS_CHECK.
+    [[nodiscard]] inline constexpr T&
+    operator[](size_t index) const ZIGLIKE_NOEXCEPT
+    {
+#ifdef ZIGLIKE_BOUNDS_CHECKED
+        if (index >= m_elements) [[unlikely]]
+            ZIGLIKE_ABORT();
+#endif
+        return m_data[index];
+    }
+
+    /// Access the item at index, or null if index is out of bounds. Always
+    /// checked, regardless of ZIGLIKE_BOUNDS_CHECK.
+    template <typename U = T>
+    [[nodiscard]] inline constexpr opt<U&>
+    at(size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        if (index >= m_elements)
+            return {};
+        return m_data[index];
+    }
+
+    /// Access the item at index without ever checking bounds. Undefined
+    /// behavior if index is out of bounds.
+    [[nodiscard]] inline constexpr T&
+    unchecked_at(size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        return m_data[index];
+    }
+
+    /// Returns the items from index from (inclusive) to index to (exclusive).
+    /// Aborts if from is greater than to or to is greater than size().
+    [[nodiscard]] inline constexpr slice subslice(size_t from, size_t to) const
+        ZIGLIKE_NOEXCEPT
+    {
+        if (from > to || to > m_elements) [[unlikely]]
+            ZIGLIKE_ABORT();
+        return slice(m_data + from, to - from);
+    }
+
+    /// Returns the first count items. Aborts if count is greater than size().
+    [[nodiscard]] inline constexpr slice first(size_t count) const
+        ZIGLIKE_NOEXCEPT
+    {
+        if (count > m_elements) [[unlikely]]
+            ZIGLIKE_ABORT();
+        return slice(m_data, count);
+    }
+
+    /// Returns the last count items. Aborts if count is greater than size().
+    [[nodiscard]] inline constexpr slice last(size_t count) const
+        ZIGLIKE_NOEXCEPT
+    {
+        if (count > m_elements) [[unlikely]]
+            ZIGLIKE_ABORT();
+        return slice(m_data + (m_elements - count), count);
+    }
+
+    /// Returns everything but the first count items. Aborts if count is
+    /// greater than size().
+    [[nodiscard]] inline constexpr slice drop_front(size_t count) const
+        ZIGLIKE_NOEXCEPT
+    {
+        if (count > m_elements) [[unlikely]]
+            ZIGLIKE_ABORT();
+        return slice(m_data + count, m_elements - count);
+    }
+
+    /// Returns the items before index and the items from index onwards. Aborts
+    /// if index is greater than size().
+    [[nodiscard]] inline constexpr std::pair<slice, slice>
+    split_at(size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        if (index > m_elements) [[unlikely]]
+            ZIGLIKE_ABORT();
+        return {slice(m_data, index),
+                slice(m_data + index, m_elements - index)};
+    }
+
+    /// Iterate over consecutive chunks of chunk_size items. Only whole chunks
+    /// are yielded, the leftover items are available from remainder(). Aborts
+    /// if chunk_size is zero.
+    [[nodiscard]] inline constexpr slice_chunks<T>
+    chunks(size_t chunk_size) const ZIGLIKE_NOEXCEPT
+    {
+        if (chunk_size == 0) [[unlikely]]
+            ZIGLIKE_ABORT();
+        return slice_chunks<T>(*this, chunk_size);
+    }
+
+    /// Iterate over consecutive chunks of N items, where N is known at compile
+    /// time, as fixed_slices. Only whole chunks are yielded, the leftover items
+    /// are available from remainder().
+    template <size_t N>
+    [[nodiscard]] inline constexpr slice_fixed_chunks<T, N>
+    chunks() const ZIGLIKE_NOEXCEPT
+    {
+        static_assert(N > 0, "Cannot split a slice into empty chunks");
+        return slice_fixed_chunks<T, N>(*this);
+    }
+
+    /// Iterate over every overlapping run of window_size items, advancing one
+    /// item at a time. Yields nothing if the slice is smaller than
+    /// window_size. Aborts if window_size is zero.
+    [[nodiscard]] inline constexpr slice_windows<T>
+    windows(size_t window_size) const ZIGLIKE_NOEXCEPT
+    {
+        if (window_size == 0) [[unlikely]]
+            ZIGLIKE_ABORT();
+        return slice_windows<T>(*this, window_size);
+    }
+
     /// Wrap a contiguous stdlib container which has data() and size() functions
     template <typename U>
     inline constexpr slice(
@@ -152,6 +288,8 @@ template <typename T> class slice
                           (std::is_same_v<typename U::value_type, TConst> ||
                            std::is_same_v<typename U::value_type, TNonConst>),
                       uninstantiable> = {}) ZIGLIKE_NOEXCEPT
+        : m_elements(other.size()),
+          m_data(other.data())
     {
         static_assert(!std::is_same_v<U, slice>,
                       "incorrect constructor selected");
@@ -160,8 +298,6 @@ template <typename T> class slice
         static_assert(!std::is_same_v<U, T>, "incorrect constructor selected");
         static_assert(!std::is_same_v<U, TNonConst>,
                       "incorrect constructor selected");
-        m_data = other.data();
-        m_elements = other.size();
     }
 
     template <typename U>
@@ -228,29 +364,58 @@ template <typename T> class slice
     slice() = delete;
 
 #ifndef ZIGLIKE_SLICE_NO_ITERATOR
-    /// The slice's iterator is the majority of the class. It is only a forwards
-    /// iterator for simplicities sake (I really never iterate in any other way)
-    struct iterator
+    /// The slice's iterator is a thin wrapper around a pointer. It is
+    /// random-access (and contiguous, in C++20) so that standard algorithms
+    /// like std::sort and std::lower_bound can jump around in O(1) and
+    /// vectorize over the underlying pointer. U is either T or const T.
+    template <typename U> struct basic_iterator
     {
-        using iterator_category = std::forward_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+#if defined(__cpp_lib_concepts)
+        using iterator_concept = std::contiguous_iterator_tag;
+#endif
         using difference_type = std::ptrdiff_t;
-        using value_type = T;
-        using pointer = value_type*;
-        using reference = value_type&;
+        using value_type = std::remove_cv_t<U>;
+        using element_type = U;
+        using pointer = U*;
+        using reference = U&;
+
+        inline constexpr basic_iterator() ZIGLIKE_NOEXCEPT = default;
+
+        inline constexpr basic_iterator(pointer ptr) ZIGLIKE_NOEXCEPT
+            : m_ptr(ptr)
+        {
+        }
 
-        inline constexpr pointer ptr() ZIGLIKE_NOEXCEPT { return m_ptr; }
+        /// A mutable iterator can always be converted to a const iterator
+        template <typename MaybeU = U>
+        inline constexpr basic_iterator(
+            std::enable_if_t<std::is_const_v<MaybeU>,
+                             const basic_iterator<TNonConst>&>
+                other) ZIGLIKE_NOEXCEPT : m_ptr(other.ptr())
+        {
+        }
 
-        inline constexpr iterator(pointer ptr) ZIGLIKE_NOEXCEPT : m_ptr(ptr) {}
+        inline constexpr pointer ptr() const ZIGLIKE_NOEXCEPT { return m_ptr; }
 
         inline constexpr reference operator*() const ZIGLIKE_NOEXCEPT
         {
             return *m_ptr;
         }
 
-        inline constexpr pointer operator->() ZIGLIKE_NOEXCEPT { return m_ptr; }
+        inline constexpr pointer operator->() const ZIGLIKE_NOEXCEPT
+        {
+            return m_ptr;
+        }
+
+        inline constexpr reference
+        operator[](difference_type index) const ZIGLIKE_NOEXCEPT
+        {
+            return m_ptr[index];
+        }
 
         // Prefix increment
-        inline constexpr iterator& operator++() ZIGLIKE_NOEXCEPT
+        inline constexpr basic_iterator& operator++() ZIGLIKE_NOEXCEPT
         {
             ++m_ptr;
             return *this;
@@ -258,81 +423,107 @@ template <typename T> class slice
 
         // Postfix increment
         // NOLINTNEXTLINE
-        inline constexpr iterator operator++(int) ZIGLIKE_NOEXCEPT
+        inline constexpr basic_iterator operator++(int) ZIGLIKE_NOEXCEPT
         {
-            iterator tmp = *this;
+            basic_iterator tmp = *this;
             ++(*this);
             return tmp;
         }
 
-        inline constexpr friend bool
-        operator==(const iterator& a, const iterator& b) ZIGLIKE_NOEXCEPT
-        {
-            return a.m_ptr == b.m_ptr;
-        };
-        inline constexpr friend bool
-        operator!=(const iterator& a, const iterator& b) ZIGLIKE_NOEXCEPT
+        // Prefix decrement
+        inline constexpr basic_iterator& operator--() ZIGLIKE_NOEXCEPT
         {
-            return a.m_ptr != b.m_ptr;
-        };
-
-      private:
-        pointer m_ptr;
-    };
+            --m_ptr;
+            return *this;
+        }
 
-    struct const_iterator
-    {
-        using iterator_category = std::forward_iterator_tag;
-        using difference_type = std::ptrdiff_t;
-        using value_type = const T;
-        using pointer = const value_type*;
-        using reference = const value_type&;
+        // Postfix decrement
+        // NOLINTNEXTLINE
+        inline constexpr basic_iterator operator--(int) ZIGLIKE_NOEXCEPT
+        {
+            basic_iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
 
-        inline constexpr pointer ptr() ZIGLIKE_NOEXCEPT { return m_ptr; }
+        inline constexpr basic_iterator&
+        operator+=(difference_type offset) ZIGLIKE_NOEXCEPT
+        {
+            m_ptr += offset;
+            return *this;
+        }
 
-        inline constexpr const_iterator(pointer ptr) ZIGLIKE_NOEXCEPT
-            : m_ptr(ptr)
+        inline constexpr basic_iterator&
+        operator-=(difference_type offset) ZIGLIKE_NOEXCEPT
         {
+            m_ptr -= offset;
+            return *this;
         }
 
-        inline constexpr reference operator*() const ZIGLIKE_NOEXCEPT
+        inline constexpr friend basic_iterator
+        operator+(basic_iterator iter, difference_type offset) ZIGLIKE_NOEXCEPT
         {
-            return *m_ptr;
+            return basic_iterator(iter.m_ptr + offset);
         }
 
-        inline constexpr pointer operator->() ZIGLIKE_NOEXCEPT { return m_ptr; }
+        inline constexpr friend basic_iterator
+        operator+(difference_type offset, basic_iterator iter) ZIGLIKE_NOEXCEPT
+        {
+            return basic_iterator(iter.m_ptr + offset);
+        }
 
-        // Prefix increment
-        inline constexpr const_iterator& operator++() ZIGLIKE_NOEXCEPT
+        inline constexpr friend basic_iterator
+        operator-(basic_iterator iter, difference_type offset) ZIGLIKE_NOEXCEPT
         {
-            ++m_ptr;
-            return *this;
+            return basic_iterator(iter.m_ptr - offset);
         }
 
-        // Postfix increment
-        // NOLINTNEXTLINE
-        inline constexpr const_iterator operator++(int) ZIGLIKE_NOEXCEPT
+        inline constexpr friend difference_type
+        operator-(const basic_iterator& a,
+                  const basic_iterator& b) ZIGLIKE_NOEXCEPT
         {
-            const_iterator tmp = *this;
-            ++(*this);
-            return tmp;
+            return a.m_ptr - b.m_ptr;
         }
 
         inline constexpr friend bool
-        operator==(const const_iterator& a,
-                   const const_iterator& b) ZIGLIKE_NOEXCEPT
+        operator==(const basic_iterator& a,
+                   const basic_iterator& b) ZIGLIKE_NOEXCEPT
         {
             return a.m_ptr == b.m_ptr;
         };
         inline constexpr friend bool
-        operator!=(const const_iterator& a,
-                   const const_iterator& b) ZIGLIKE_NOEXCEPT
+        operator!=(const basic_iterator& a,
+                   const basic_iterator& b) ZIGLIKE_NOEXCEPT
         {
             return a.m_ptr != b.m_ptr;
         };
+        inline constexpr friend bool
+        operator<(const basic_iterator& a,
+                  const basic_iterator& b) ZIGLIKE_NOEXCEPT
+        {
+            return a.m_ptr < b.m_ptr;
+        };
+        inline constexpr friend bool
+        operator>(const basic_iterator& a,
+                  const basic_iterator& b) ZIGLIKE_NOEXCEPT
+        {
+            return a.m_ptr > b.m_ptr;
+        };
+        inline constexpr friend bool
+        operator<=(const basic_iterator& a,
+                   const basic_iterator& b) ZIGLIKE_NOEXCEPT
+        {
+            return a.m_ptr <= b.m_ptr;
+        };
+        inline constexpr friend bool
+        operator>=(const basic_iterator& a,
+                   const basic_iterator& b) ZIGLIKE_NOEXCEPT
+        {
+            return a.m_ptr >= b.m_ptr;
+        };
 
       private:
-        pointer m_ptr;
+        pointer m_ptr = nullptr;
     };
 #endif
 
@@ -352,8 +543,232 @@ template <typename T>
     return slice<T>(std::addressof(data), size);
 }
 
+#ifndef ZIGLIKE_NO_SMALL_OPTIONAL_SLICE
+/// Slices are never null, so a null data pointer is a niche.
+template <typename T> struct niche<slice<T>>
+{
+    static constexpr size_t count = 1;
+
+    [[nodiscard]] static inline constexpr slice<T> make(size_t) noexcept
+    {
+        return slice<T>(typename slice<T>::null_t{});
+    }
+
+    [[nodiscard]] static inline constexpr size_t
+    index_of(const slice<T>& item) noexcept
+    {
+        return item.data() == nullptr ? 0 : 1;
+    }
+};
+#endif
+
+#ifndef ZIGLIKE_SLICE_NO_ITERATOR
+namespace detail {
+/// Forward iterator over a range which produces its items by index, used by
+/// the chunk and window ranges of slice.
+template <typename Range> struct indexed_range_iterator
+{
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = decltype(std::declval<const Range&>()[0]);
+    using pointer = void;
+    using reference = value_type;
+
+    inline constexpr indexed_range_iterator(const Range& range,
+                                            size_t index) ZIGLIKE_NOEXCEPT
+        : m_range(range),
+          m_index(index)
+    {
+    }
+
+    inline constexpr value_type operator*() const ZIGLIKE_NOEXCEPT
+    {
+        return m_range[m_index];
+    }
+
+    // Prefix increment
+    inline constexpr indexed_range_iterator& operator++() ZIGLIKE_NOEXCEPT
+    {
+        ++m_index;
+        return *this;
+    }
+
+    // Postfix increment
+    // NOLINTNEXTLINE
+    inline constexpr indexed_range_iterator operator++(int) ZIGLIKE_NOEXCEPT
+    {
+        indexed_range_iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    inline constexpr friend bool
+    operator==(const indexed_range_iterator& a,
+               const indexed_range_iterator& b) ZIGLIKE_NOEXCEPT
+    {
+        return a.m_index == b.m_index;
+    };
+    inline constexpr friend bool
+    operator!=(const indexed_range_iterator& a,
+               const indexed_range_iterator& b) ZIGLIKE_NOEXCEPT
+    {
+        return a.m_index != b.m_index;
+    };
+
+  private:
+    Range m_range;
+    size_t m_index;
+};
+} // namespace detail
+#endif
+
+/// The range returned by slice::chunks(size_t).
+template <typename T> class slice_chunks
+{
+  public:
+    /// Number of whole chunks.
+    [[nodiscard]] inline constexpr size_t size() const ZIGLIKE_NOEXCEPT
+    {
+        return m_slice.size() / m_chunk_size;
+    }
+
+    [[nodiscard]] inline constexpr slice<T>
+    operator[](size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        return raw_slice(m_slice.data()[index * m_chunk_size], m_chunk_size);
+    }
+
+    /// The items after the last whole chunk, fewer than the chunk size.
+    [[nodiscard]] inline constexpr slice<T> remainder() const ZIGLIKE_NOEXCEPT
+    {
+        return m_slice.drop_front(size() * m_chunk_size);
+    }
+
+#ifndef ZIGLIKE_SLICE_NO_ITERATOR
+    using iterator = detail::indexed_range_iterator<slice_chunks>;
+
+    inline constexpr iterator begin() const ZIGLIKE_NOEXCEPT
+    {
+        return iterator(*this, 0);
+    }
+    inline constexpr iterator end() const ZIGLIKE_NOEXCEPT
+    {
+        return iterator(*this, size());
+    }
+#endif
+
+  private:
+    friend class slice<T>;
+    inline constexpr slice_chunks(slice<T> slice,
+                                  size_t chunk_size) ZIGLIKE_NOEXCEPT
+        : m_slice(slice),
+          m_chunk_size(chunk_size)
+    {
+    }
+
+    slice<T> m_slice;
+    size_t m_chunk_size;
+};
+
+/// The range returned by slice::chunks<N>(). Since the chunk size is a
+/// constant, loops over each chunk can be fully unrolled.
+template <typename T, size_t N> class slice_fixed_chunks
+{
+  public:
+    static constexpr size_t chunk_size = N;
+
+    /// Number of whole chunks.
+    [[nodiscard]] inline constexpr size_t size() const ZIGLIKE_NOEXCEPT
+    {
+        return m_slice.size() / N;
+    }
+
+    [[nodiscard]] inline constexpr fixed_slice<T, N>
+    operator[](size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        return raw_fixed_slice<N>(m_slice.data()[index * N]);
+    }
+
+    /// The items after the last whole chunk, fewer than N.
+    [[nodiscard]] inline constexpr slice<T> remainder() const ZIGLIKE_NOEXCEPT
+    {
+        return m_slice.drop_front(size() * N);
+    }
+
+#ifndef ZIGLIKE_SLICE_NO_ITERATOR
+    using iterator = detail::indexed_range_iterator<slice_fixed_chunks>;
+
+    inline constexpr iterator begin() const ZIGLIKE_NOEXCEPT
+    {
+        return iterator(*this, 0);
+    }
+    inline constexpr iterator end() const ZIGLIKE_NOEXCEPT
+    {
+        return iterator(*this, size());
+    }
+#endif
+
+  private:
+    friend class slice<T>;
+    inline constexpr slice_fixed_chunks(slice<T> slice) ZIGLIKE_NOEXCEPT
+        : m_slice(slice)
+    {
+    }
+
+    slice<T> m_slice;
+};
+
+/// The range returned by slice::windows().
+template <typename T> class slice_windows
+{
+  public:
+    /// Number of windows.
+    [[nodiscard]] inline constexpr size_t size() const ZIGLIKE_NOEXCEPT
+    {
+        return m_slice.size() < m_window_size
+                   ? 0
+                   : m_slice.size() - m_window_size + 1;
+    }
+
+    [[nodiscard]] inline constexpr slice<T>
+    operator[](size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        return raw_slice(m_slice.data()[index], m_window_size);
+    }
+
+#ifndef ZIGLIKE_SLICE_NO_ITERATOR
+    using iterator = detail::indexed_range_iterator<slice_windows>;
+
+    inline constexpr iterator begin() const ZIGLIKE_NOEXCEPT
+    {
+        return iterator(*this, 0);
+    }
+    inline constexpr iterator end() const ZIGLIKE_NOEXCEPT
+    {
+        return iterator(*this, size());
+    }
+#endif
+
+  private:
+    friend class slice<T>;
+    inline constexpr slice_windows(slice<T> slice,
+                                   size_t window_size) ZIGLIKE_NOEXCEPT
+        : m_slice(slice),
+          m_window_size(window_size)
+    {
+    }
+
+    slice<T> m_slice;
+    size_t m_window_size;
+};
+
 } // namespace zl
 
+// needed for slice::at() and slice::chunks<N>(), included after slice since
+// both of these also include slice
+#include "ziglike/fixed_slice.h"
+#include "ziglike/opt.h"
+
 #ifdef ZIGLIKE_USE_FMT
 template <typename T> struct fmt::formatter<zl::slice<T>>
 {
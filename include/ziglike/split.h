@@ -0,0 +1,341 @@
+#pragma once
+
+#include "ziglike/detail/abort.h"
+#include "ziglike/opt.h"
+#include "ziglike/slice.h"
+#include "ziglike/stdmem.h"
+
+#ifndef ZIGLIKE_SLICE_NO_ITERATOR
+#include <iterator>
+#endif
+
+#ifndef ZIGLIKE_NOEXCEPT
+#define ZIGLIKE_NOEXCEPT noexcept
+#endif
+
+namespace zl {
+namespace detail {
+/// Delimiters used by splitter. Each one can find its next occurrence in a
+/// buffer, and check whether a buffer starts with it.
+
+template <typename T> struct scalar_delimiter
+{
+    T value;
+
+    /// Index of the first delimiter in the size items at data, or size.
+    [[nodiscard]] inline size_t find(const T* data,
+                                     size_t size) const ZIGLIKE_NOEXCEPT
+    {
+        return find_first(data, size, value);
+    }
+
+    [[nodiscard]] inline bool starts(const T* data,
+                                     size_t size) const ZIGLIKE_NOEXCEPT
+    {
+        return size != 0 && data[0] == value;
+    }
+
+    [[nodiscard]] inline constexpr size_t length() const ZIGLIKE_NOEXCEPT
+    {
+        return 1;
+    }
+};
+
+template <typename T> struct any_delimiter
+{
+    slice<const T> values;
+
+    [[nodiscard]] inline size_t find(const T* data,
+                                     size_t size) const ZIGLIKE_NOEXCEPT
+    {
+        if (values.size() == 0)
+            return size;
+        return find_first_any(data, size, values.data(), values.size());
+    }
+
+    [[nodiscard]] inline bool starts(const T* data,
+                                     size_t size) const ZIGLIKE_NOEXCEPT
+    {
+        if (size == 0)
+            return false;
+        for (const T& value : values) {
+            if (data[0] == value)
+                return true;
+        }
+        return false;
+    }
+
+    [[nodiscard]] inline constexpr size_t length() const ZIGLIKE_NOEXCEPT
+    {
+        return 1;
+    }
+};
+
+template <typename T> struct sequence_delimiter
+{
+    slice<const T> sequence;
+
+    [[nodiscard]] inline size_t find(const T* data,
+                                     size_t size) const ZIGLIKE_NOEXCEPT
+    {
+        if (sequence.size() > size)
+            return size;
+        if (sequence.size() == 1)
+            return find_first(data, size, sequence.data()[0]);
+        const opt<size_t> index =
+            index_of(raw_slice(*data, size), sequence);
+        return index.has_value() ? index.value() : size;
+    }
+
+    [[nodiscard]] inline bool starts(const T* data,
+                                     size_t size) const ZIGLIKE_NOEXCEPT
+    {
+        return sequence.size() <= size &&
+               memcompare(raw_slice(*data, sequence.size()), sequence);
+    }
+
+    [[nodiscard]] inline constexpr size_t length() const ZIGLIKE_NOEXCEPT
+    {
+        return sequence.size();
+    }
+};
+} // namespace detail
+
+/// Lazily splits a slice into subslices separated by a delimiter, without
+/// allocating. Modelled after Zig's std.mem.SplitIterator and TokenIterator:
+/// if skip_empty is false, every delimiter separates two items, even if they
+/// are empty. If skip_empty is true, runs of delimiters are treated as one and
+/// empty items are never returned.
+/// Can be used with next() like in Zig, or in a range-for loop.
+template <typename T, typename Delimiter, bool skip_empty> class splitter
+{
+  private:
+    static constexpr size_t done = size_t(-1);
+
+    slice<const T> m_buffer;
+    /// Index of the first item not yet returned, or done when a splitter
+    /// which does not skip empty items has returned the last one.
+    size_t m_index = 0;
+    Delimiter m_delimiter;
+
+    /// Advance past any delimiters at m_index, when skipping empty items.
+    inline void skip_delimiters() ZIGLIKE_NOEXCEPT
+    {
+        if constexpr (skip_empty) {
+            while (m_delimiter.starts(m_buffer.data() + m_index,
+                                      m_buffer.size() - m_index)) {
+                m_index += m_delimiter.length();
+            }
+        }
+    }
+
+  public:
+    using value_type = slice<const T>;
+
+    inline constexpr splitter(slice<const T> buffer,
+                              Delimiter delimiter) ZIGLIKE_NOEXCEPT
+        : m_buffer(buffer),
+          m_delimiter(delimiter)
+    {
+        if (m_delimiter.length() == 0) [[unlikely]]
+            ZIGLIKE_ABORT();
+    }
+
+    /// Returns the next item and advances past it, or null if there are no
+    /// more items.
+    [[nodiscard]] inline opt<slice<const T>> next() ZIGLIKE_NOEXCEPT
+    {
+        skip_delimiters();
+        if (m_index == done || (skip_empty && m_index == m_buffer.size()))
+            return {};
+
+        const size_t start = m_index;
+        const size_t end = start + m_delimiter.find(m_buffer.data() + start,
+                                                    m_buffer.size() - start);
+        if (end == m_buffer.size()) {
+            m_index = skip_empty ? end : done;
+        } else {
+            m_index = skip_empty ? end : end + m_delimiter.length();
+        }
+        return slice<const T>(m_buffer, start, end);
+    }
+
+    /// Returns the next item without advancing, or null if there are no more
+    /// items.
+    [[nodiscard]] inline opt<slice<const T>> peek() const ZIGLIKE_NOEXCEPT
+    {
+        splitter copy = *this;
+        return copy.next();
+    }
+
+    /// The part of the buffer which has not been returned yet.
+    [[nodiscard]] inline slice<const T> rest() const ZIGLIKE_NOEXCEPT
+    {
+        splitter copy = *this;
+        copy.skip_delimiters();
+        const size_t start =
+            copy.m_index == done ? m_buffer.size() : copy.m_index;
+        return slice<const T>(m_buffer, start, m_buffer.size());
+    }
+
+    /// Start over from the beginning of the buffer.
+    inline void reset() ZIGLIKE_NOEXCEPT { m_index = 0; }
+
+#ifndef ZIGLIKE_SLICE_NO_ITERATOR
+    struct iterator;
+
+    inline iterator begin() const ZIGLIKE_NOEXCEPT { return iterator(*this); }
+    inline iterator end() const ZIGLIKE_NOEXCEPT
+    {
+        return iterator(*this, typename iterator::end_tag{});
+    }
+
+    /// Forward iterator over the remaining items. Holds its own copy of the
+    /// splitter, so iterating does not advance the splitter it came from.
+    struct iterator
+    {
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = slice<const T>;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        inline iterator(const splitter& parent) ZIGLIKE_NOEXCEPT
+            : m_splitter(parent),
+              m_current(m_splitter.next())
+        {
+        }
+
+        struct end_tag
+        {};
+        inline iterator(const splitter& parent, end_tag) ZIGLIKE_NOEXCEPT
+            : m_splitter(parent)
+        {
+        }
+
+        inline reference operator*() const ZIGLIKE_NOEXCEPT
+        {
+            return m_current.value();
+        }
+
+        inline pointer operator->() const ZIGLIKE_NOEXCEPT
+        {
+            return std::addressof(m_current.value());
+        }
+
+        // Prefix increment
+        inline iterator& operator++() ZIGLIKE_NOEXCEPT
+        {
+            m_current = m_splitter.next();
+            return *this;
+        }
+
+        // Postfix increment
+        // NOLINTNEXTLINE
+        inline iterator operator++(int) ZIGLIKE_NOEXCEPT
+        {
+            iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        inline friend bool operator==(const iterator& a,
+                                      const iterator& b) ZIGLIKE_NOEXCEPT
+        {
+            if (!a.m_current.has_value() || !b.m_current.has_value())
+                return a.m_current.has_value() == b.m_current.has_value();
+            return a.m_current.value() == b.m_current.value();
+        }
+
+        inline friend bool operator!=(const iterator& a,
+                                      const iterator& b) ZIGLIKE_NOEXCEPT
+        {
+            return !(a == b);
+        }
+
+      private:
+        splitter m_splitter;
+        opt<slice<const T>> m_current;
+    };
+#endif
+};
+
+template <typename T>
+using split_scalar_iterator =
+    splitter<T, detail::scalar_delimiter<std::remove_const_t<T>>, false>;
+template <typename T>
+using split_any_iterator =
+    splitter<T, detail::any_delimiter<std::remove_const_t<T>>, false>;
+template <typename T>
+using split_sequence_iterator =
+    splitter<T, detail::sequence_delimiter<std::remove_const_t<T>>, false>;
+template <typename T>
+using tokenize_scalar_iterator =
+    splitter<T, detail::scalar_delimiter<std::remove_const_t<T>>, true>;
+template <typename T>
+using tokenize_any_iterator =
+    splitter<T, detail::any_delimiter<std::remove_const_t<T>>, true>;
+template <typename T>
+using tokenize_sequence_iterator =
+    splitter<T, detail::sequence_delimiter<std::remove_const_t<T>>, true>;
+
+/// Split buffer on every occurrence of delimiter. "a,,b" split on ',' gives
+/// "a", "", and "b".
+template <typename T>
+[[nodiscard]] inline split_scalar_iterator<std::remove_const_t<T>>
+split_scalar(slice<T> buffer,
+             const std::remove_const_t<T>& delimiter) ZIGLIKE_NOEXCEPT
+{
+    return {buffer, {delimiter}};
+}
+
+/// Split buffer on every occurrence of any of the items in delimiters.
+template <typename T>
+[[nodiscard]] inline split_any_iterator<std::remove_const_t<T>>
+split_any(slice<T> buffer,
+          slice<const std::remove_const_t<T>> delimiters) ZIGLIKE_NOEXCEPT
+{
+    return {buffer, {delimiters}};
+}
+
+/// Split buffer on every occurrence of the sequence delimiter, which must not
+/// be empty.
+template <typename T>
+[[nodiscard]] inline split_sequence_iterator<std::remove_const_t<T>>
+split_sequence(slice<T> buffer,
+               slice<const std::remove_const_t<T>> delimiter) ZIGLIKE_NOEXCEPT
+{
+    return {buffer, {delimiter}};
+}
+
+/// Split buffer on runs of delimiter, never returning empty items. "a,,b"
+/// tokenized on ',' gives "a" and "b".
+template <typename T>
+[[nodiscard]] inline tokenize_scalar_iterator<std::remove_const_t<T>>
+tokenize_scalar(slice<T> buffer,
+                const std::remove_const_t<T>& delimiter) ZIGLIKE_NOEXCEPT
+{
+    return {buffer, {delimiter}};
+}
+
+/// Split buffer on runs of any of the items in delimiters, never returning
+/// empty items.
+template <typename T>
+[[nodiscard]] inline tokenize_any_iterator<std::remove_const_t<T>>
+tokenize_any(slice<T> buffer,
+             slice<const std::remove_const_t<T>> delimiters) ZIGLIKE_NOEXCEPT
+{
+    return {buffer, {delimiters}};
+}
+
+/// Split buffer on runs of the sequence delimiter, never returning empty
+/// items. delimiter must not be empty.
+template <typename T>
+[[nodiscard]] inline tokenize_sequence_iterator<std::remove_const_t<T>>
+tokenize_sequence(slice<T> buffer,
+                  slice<const std::remove_const_t<T>> delimiter)
+    ZIGLIKE_NOEXCEPT
+{
+    return {buffer, {delimiter}};
+}
+} // namespace zl
@@ -1,9 +1,25 @@
 #pragma once
 
+#include "ziglike/aligned_slice.h"
+#include "ziglike/detail/simd.h"
+#include "ziglike/fixed_slice.h"
+#include "ziglike/joined_slice.h"
+#include "ziglike/opt.h"
 #include "ziglike/slice.h"
+#include "ziglike/strided_slice.h"
 #include <cstdint>
 #include <cstring>
 
+#ifndef ZIGLIKE_STDMEM_NO_THREADS
+#include <thread>
+#include <vector>
+#endif
+
+// The constexpr functions below which use vector instructions or memcpy at
+// runtime can only be used in constant expressions when
+// ZIGLIKE_HAS_CONSTANT_EVALUATED is defined, that is in C++20 or with GCC or
+// clang. See detail/simd.h.
+
 namespace zl {
 /// Copy the contents of source into destination, byte by byte, without invoking
 /// any copy constructors or destructors.
@@ -19,16 +35,110 @@ template <typename T>
 constexpr bool memcopy_lenient(zl::slice<T> destination,
                                zl::slice<T> source) noexcept;
 
+/// Overloads of memcopy, memcompare and memfill for fixed_slices. The size is
+/// a compile-time constant, so these compile down to a few unrolled loads and
+/// stores for small N, and they can be used in constant expressions (where
+/// memcopy cannot detect overlap, and memcompare only supports integers and
+/// enums). memcopy's source may be a fixed_slice of const items.
+template <typename T, typename U, size_t N>
+constexpr bool memcopy(zl::fixed_slice<T, N> destination,
+                       zl::fixed_slice<U, N> source) noexcept;
+
+template <typename T, size_t N>
+constexpr bool memcompare(zl::fixed_slice<T, N> memory_1,
+                          zl::fixed_slice<T, N> memory_2) noexcept;
+
+template <typename T, size_t N>
+constexpr void memfill(zl::fixed_slice<T, N> slice, T original) noexcept;
+
+/// Overloads of memcopy, memcompare and memfill for aligned slices. Behave the
+/// same as the slice versions, but use aligned vector loads and stores with no
+/// misaligned head when Align is at least the vector width.
+template <typename T, size_t Align>
+bool memcopy(zl::aligned_slice<T, Align> destination,
+             zl::aligned_slice<T, Align> source) noexcept;
+
+template <typename T, size_t Align>
+bool memcompare(zl::aligned_slice<T, Align> memory_1,
+                zl::aligned_slice<T, Align> memory_2) noexcept;
+
+template <typename T, size_t Align>
+void memfill(zl::aligned_slice<T, Align> slice, T original) noexcept;
+
+#ifndef ZIGLIKE_SLICE_NO_ITERATOR
+/// Overloads of memcopy and memcompare for joined slices, which work segment
+/// by segment with the same vectorized code as the contiguous versions, instead
+/// of item by item. The total sizes must match, and memcopy returns false and
+/// does nothing if any segment overlaps the contiguous slice.
+template <typename T>
+bool memcopy(zl::slice<T> destination, zl::joined_slice<T> source) noexcept;
+
+template <typename T>
+bool memcopy(zl::joined_slice<T> destination, zl::slice<T> source) noexcept;
+
+template <typename T>
+bool memcompare(zl::joined_slice<T> memory_1, zl::slice<T> memory_2) noexcept;
+
+template <typename T>
+bool memcompare(zl::joined_slice<T> memory_1,
+                zl::joined_slice<T> memory_2) noexcept;
+#endif
+
+/// Size in bytes above which the streaming variants of the stdmem functions
+/// bypass the cache. Should be roughly the size of the last level cache.
+#ifndef ZIGLIKE_STREAMING_THRESHOLD
+#define ZIGLIKE_STREAMING_THRESHOLD (size_t(8) * 1024 * 1024)
+#endif
+
+/// Identical to memcopy, except that if the slices are at least threshold
+/// bytes large, the destination is written with non-temporal stores which do
+/// not pull it into the cache. Use this for large copies whose destination will
+/// not be read again soon, so that they do not evict the rest of the program's
+/// working set. With ZIGLIKE_NO_SIMD there are no non-temporal stores, and this
+/// is a plain memcopy.
+template <typename T>
+bool memcopy_streaming(zl::slice<T> destination, zl::slice<T> source,
+                       size_t threshold = ZIGLIKE_STREAMING_THRESHOLD) noexcept;
+
 /// Compare two slices of memory, byte by byte, without invoking any == operator
 /// overloads.
 /// The memory can overlap and alias (in the latter case the function just
 /// returns true).
 /// If the two slices of memory are differently size, the function immediately
 /// returns false;
+/// Uses vector instructions when available. In constant evaluation, slices of
+/// integers or enums are compared element by element instead.
 template <typename T>
 constexpr bool memcompare(zl::slice<T> memory_1,
                           zl::slice<T> memory_2) noexcept;
 
+/// Result of a three-way comparison.
+enum class ordering : int8_t
+{
+    less = -1,
+    equal = 0,
+    greater = 1,
+};
+
+/// Result of memorder: how the first slice orders relative to the second, and
+/// the index of the first element which differs between them. If one slice is
+/// a prefix of the other, index is the size of the shorter one. If the slices
+/// are equal, index is their size.
+struct memorder_result
+{
+    ordering order;
+    size_t index;
+};
+
+/// Lexicographically compare two slices of memory, without invoking any
+/// comparison operator overloads, and find the first element where they
+/// differ. Integers and enums are ordered by value, every other type is
+/// ordered by its bytes, like std::memcmp.
+/// Uses vector instructions when available.
+template <typename T>
+constexpr memorder_result memorder(zl::slice<T> memory_1,
+                                   zl::slice<T> memory_2) noexcept;
+
 /// Check if slice "inner" points only to items also pointed at by slice "outer"
 template <typename T>
 constexpr bool memcontains(zl::slice<T> outer, zl::slice<T> inner) noexcept;
@@ -45,8 +155,895 @@ constexpr bool memoverlaps(zl::slice<T> a, zl::slice<T> b) noexcept;
 /// Fills a block of memory of type T by copying an instance of T into every
 /// spot in that memory. T must be nothrow copy constructible. Does not invoke
 /// destructors of any items already in the memory.
+/// Trivially copyable types are filled with broadcast vector stores, or by
+/// repeatedly doubling a memcpy'd pattern if their size does not evenly divide
+/// a vector.
 template <typename T>
 constexpr void memfill(zl::slice<T> slice, T original) noexcept;
+
+/// Identical to memfill, except that if the slice is at least threshold bytes
+/// large, the memory is written with non-temporal stores which do not pull it
+/// into the cache. Use this for buffers which will not be read again soon.
+/// T must be trivially copyable. Non-temporal stores are only used for types
+/// whose size evenly divides a vector, and not with ZIGLIKE_NO_SIMD; anything
+/// else is filled with ordinary cached stores, exactly like memfill.
+template <typename T>
+void memfill_streaming(
+    zl::slice<T> slice, T original,
+    size_t threshold = ZIGLIKE_STREAMING_THRESHOLD) noexcept;
+
+/// Copy every item referenced by the strided slice source into the contiguous
+/// destination, without invoking any copy constructors. T must be trivially
+/// copyable. If the two are not the same size, or if they overlap, the function
+/// returns false and does nothing. Otherwise, it returns true.
+/// Four and eight byte items are loaded with gather instructions where
+/// available.
+template <typename T>
+bool memgather(zl::slice<T> destination,
+               zl::strided_slice<T> source) noexcept;
+
+/// The inverse of memgather: copy the contiguous source into every item
+/// referenced by the strided slice destination. Returns false and does nothing
+/// if the two are not the same size or if they overlap.
+template <typename T>
+bool memscatter(zl::strided_slice<T> destination,
+                zl::slice<T> source) noexcept;
+
+/// Find the index of the first item in haystack which is equal to needle.
+/// Integers, enums, and pointers are searched with vector instructions when
+/// available, anything else is compared with its == operator.
+template <typename T>
+constexpr opt<size_t>
+index_of_scalar(zl::slice<T> haystack,
+                const std::remove_const_t<T>& needle) noexcept;
+
+/// Find the index of the last item in haystack which is equal to needle.
+template <typename T>
+constexpr opt<size_t>
+last_index_of_scalar(zl::slice<T> haystack,
+                     const std::remove_const_t<T>& needle) noexcept;
+
+/// Find the index of the first item in haystack which is equal to any of the
+/// items in values.
+template <typename T>
+constexpr opt<size_t>
+index_of_any(zl::slice<T> haystack,
+             zl::slice<const std::remove_const_t<T>> values) noexcept;
+
+/// Count the number of items in haystack which are equal to needle.
+template <typename T>
+constexpr size_t count_scalar(zl::slice<T> haystack,
+                              const std::remove_const_t<T>& needle) noexcept;
+
+/// Find the index of the first occurrence of needle as a contiguous sequence
+/// inside of haystack. An empty needle is found at index 0.
+/// Integers, enums, and pointers are searched in linear time with the Two-Way
+/// algorithm, after a vector prefilter which looks for the first and last item
+/// of needle. Anything else uses a naive search with its == operator.
+template <typename T>
+constexpr opt<size_t>
+index_of(zl::slice<T> haystack,
+         zl::slice<const std::remove_const_t<T>> needle) noexcept;
+
+/// View the memory referenced by a slice as bytes, for hashing, I/O, or
+/// comparison. Like Zig's std.mem.sliceAsBytes.
+template <typename T>
+zl::slice<const uint8_t> as_bytes(zl::slice<T> slice) noexcept;
+
+/// View the memory referenced by a slice of nonconst items as writable bytes.
+/// T must be trivially copyable, so that writing its bytes is well defined.
+template <typename T>
+zl::slice<uint8_t> as_writable_bytes(zl::slice<T> slice) noexcept;
+
+/// Reinterpret a buffer of bytes as a slice of T without copying, for example
+/// to read records out of a file or network buffer. Returns null if the size
+/// of bytes is not a multiple of sizeof(T), or if its data is not aligned to
+/// alignof(T). T must be trivially copyable, and it must be const if bytes is.
+template <typename T>
+opt<zl::slice<T>> bytes_as(
+    zl::slice<std::conditional_t<std::is_const_v<T>, const uint8_t, uint8_t>>
+        bytes) noexcept;
+
+#ifndef ZIGLIKE_SLICE_NO_ITERATOR
+/// Find the index of the first occurrence of needle in haystack, counting
+/// items across all of its segments. Matches may span segment boundaries.
+/// Each segment is searched with index_of, and then the starting positions
+/// within needle.size() - 1 items of the end of the segment are checked one by
+/// one, so this is fastest when needle is short compared to the segments.
+template <typename T>
+opt<size_t> index_of(zl::joined_slice<T> haystack,
+                     zl::slice<const std::remove_const_t<T>> needle) noexcept;
+#endif
+
+#ifndef ZIGLIKE_STDMEM_NO_THREADS
+/// Executor for the parallel stdmem functions which runs tasks on newly
+/// spawned std::threads, plus the calling thread. Any type with the same two
+/// member functions can be passed instead, for example a wrapper around an
+/// existing thread pool.
+struct thread_executor
+{
+    /// Total number of threads to run on, including the calling thread. Zero
+    /// means std::thread::hardware_concurrency().
+    size_t threads = 0;
+
+    /// How many tasks can usefully run at once.
+    [[nodiscard]] inline size_t concurrency() const noexcept
+    {
+        if (threads != 0)
+            return threads;
+        const size_t hardware = std::thread::hardware_concurrency();
+        return hardware == 0 ? 1 : hardware;
+    }
+
+    /// Call task(i) for every i in [0, task_count), and return once all of
+    /// the calls have returned. If threads cannot be spawned, the remaining
+    /// tasks run on the calling thread.
+    template <typename Task>
+    inline void run(size_t task_count, const Task& task) const noexcept;
+};
+
+/// Minimum number of bytes given to each task by the parallel stdmem
+/// functions. Below this, the cost of waking a thread outweighs the copy.
+#ifndef ZIGLIKE_PARALLEL_MIN_CHUNK
+#define ZIGLIKE_PARALLEL_MIN_CHUNK (size_t(1024) * 1024)
+#endif
+
+/// Identical to memcopy, except the copy is split into cache line aligned
+/// chunks which are run by executor. See thread_executor for what an executor
+/// must provide. Returns false and does nothing under the same conditions as
+/// memcopy.
+template <typename T, typename Executor = thread_executor>
+bool memcopy_parallel(zl::slice<T> destination, zl::slice<T> source,
+                      const Executor& executor = {}) noexcept;
+
+/// Identical to memfill, except the fill is split into cache line aligned
+/// chunks which are run by executor.
+template <typename T, typename Executor = thread_executor>
+void memfill_parallel(zl::slice<T> slice, T original,
+                      const Executor& executor = {}) noexcept;
+#endif
+
+namespace detail {
+/// Returns true if the size bytes at a and b are identical. If aligned is
+/// true, a and b must both be aligned to the vector width.
+template <bool aligned = false>
+inline bool bytes_equal(const uint8_t* a, const uint8_t* b,
+                        size_t size) noexcept
+{
+    size_t i = 0;
+#ifdef ZIGLIKE_SIMD
+    using simd::vec;
+    const auto load = [](const uint8_t* bytes) {
+        if constexpr (aligned)
+            return vec::load_aligned(bytes);
+        else
+            return vec::load(bytes);
+    };
+    // four vectors per iteration, reduced into one mask check
+    for (; i + (4 * vec::width) <= size; i += 4 * vec::width) {
+        const vec eq_0 = load(a + i) == load(b + i);
+        const vec eq_1 = load(a + i + vec::width) == load(b + i + vec::width);
+        const vec eq_2 = load(a + i + (2 * vec::width)) ==
+                         load(b + i + (2 * vec::width));
+        const vec eq_3 = load(a + i + (3 * vec::width)) ==
+                         load(b + i + (3 * vec::width));
+        if (((eq_0 & eq_1) & (eq_2 & eq_3)).mask() != vec::full_mask)
+            return false;
+    }
+    for (; i + vec::width <= size; i += vec::width) {
+        if ((load(a + i) == load(b + i)).mask() != vec::full_mask)
+            return false;
+    }
+#endif
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        if (load_word(a + i) != load_word(b + i))
+            return false;
+    }
+    for (; i < size; ++i) {
+        if (a[i] != b[i])
+            return false;
+    }
+    return true;
+}
+
+/// Returns the index of the first byte which differs between a and b, or size
+/// if they are identical.
+inline size_t first_mismatch(const uint8_t* a, const uint8_t* b,
+                             size_t size) noexcept
+{
+    size_t i = 0;
+#ifdef ZIGLIKE_SIMD
+    using simd::vec;
+    for (; i + (2 * vec::width) <= size; i += 2 * vec::width) {
+        const vec eq_lo = vec::load(a + i) == vec::load(b + i);
+        const vec eq_hi =
+            vec::load(a + i + vec::width) == vec::load(b + i + vec::width);
+        if ((eq_lo & eq_hi).mask() != vec::full_mask) {
+            const uint64_t lo = eq_lo.mask() ^ vec::full_mask;
+            if (lo != 0)
+                return i + (lowest_bit(lo) / vec::mask_stride);
+            const uint64_t hi = eq_hi.mask() ^ vec::full_mask;
+            return i + vec::width + (lowest_bit(hi) / vec::mask_stride);
+        }
+    }
+    for (; i + vec::width <= size; i += vec::width) {
+        const uint64_t differing =
+            (vec::load(a + i) == vec::load(b + i)).mask() ^ vec::full_mask;
+        if (differing != 0)
+            return i + (lowest_bit(differing) / vec::mask_stride);
+    }
+#endif
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        const uint64_t differing = load_word(a + i) ^ load_word(b + i);
+        if (differing != 0) {
+#ifdef ZIGLIKE_LITTLE_ENDIAN
+            return i + (lowest_bit(differing) / 8);
+#else
+            // let the byte loop find which one it was
+            break;
+#endif
+        }
+    }
+    for (; i < size; ++i) {
+        if (a[i] != b[i])
+            return i;
+    }
+    return size;
+}
+
+/// Copy size bytes from source to destination, using non-temporal stores for
+/// everything past the first aligned address in destination.
+inline void copy_streaming(uint8_t* destination, const uint8_t* source,
+                           size_t size) noexcept
+{
+#ifdef ZIGLIKE_SIMD
+    using simd::vec;
+    const size_t misalignment =
+        reinterpret_cast<uintptr_t>(destination) % vec::width;
+    size_t i = misalignment == 0 ? 0 : vec::width - misalignment;
+    if (i > size)
+        i = size;
+    std::memcpy(destination, source, i);
+    for (; i + (4 * vec::width) <= size; i += 4 * vec::width) {
+        const vec a = vec::load(source + i);
+        const vec b = vec::load(source + i + vec::width);
+        const vec c = vec::load(source + i + (2 * vec::width));
+        const vec d = vec::load(source + i + (3 * vec::width));
+        a.stream(destination + i);
+        b.stream(destination + i + vec::width);
+        c.stream(destination + i + (2 * vec::width));
+        d.stream(destination + i + (3 * vec::width));
+    }
+    for (; i + vec::width <= size; i += vec::width) {
+        vec::load(source + i).stream(destination + i);
+    }
+    vec::stream_fence();
+    std::memcpy(destination + i, source + i, size - i);
+#else
+    std::memcpy(destination, source, size);
+#endif
+}
+
+/// Copy size bytes from source to destination, which must both be aligned to
+/// the vector width, with aligned vector loads and stores.
+inline void copy_aligned(uint8_t* destination, const uint8_t* source,
+                         size_t size) noexcept
+{
+    size_t i = 0;
+#ifdef ZIGLIKE_SIMD
+    using simd::vec;
+    for (; i + (4 * vec::width) <= size; i += 4 * vec::width) {
+        const vec a = vec::load_aligned(source + i);
+        const vec b = vec::load_aligned(source + i + vec::width);
+        const vec c = vec::load_aligned(source + i + (2 * vec::width));
+        const vec d = vec::load_aligned(source + i + (3 * vec::width));
+        a.store_aligned(destination + i);
+        b.store_aligned(destination + i + vec::width);
+        c.store_aligned(destination + i + (2 * vec::width));
+        d.store_aligned(destination + i + (3 * vec::width));
+    }
+    for (; i + vec::width <= size; i += vec::width) {
+        vec::load_aligned(source + i).store_aligned(destination + i);
+    }
+#endif
+    std::memcpy(destination + i, source + i, size - i);
+}
+
+/// Copy count items, stride items apart in source, to destination.
+template <typename T>
+inline void gather(T* destination, const T* source, size_t count,
+                   size_t stride) noexcept
+{
+    size_t i = 0;
+#if defined(ZIGLIKE_SIMD_AVX2)
+    if constexpr (sizeof(T) == 4) {
+        // indices are 32 bit, so only small strides can be gathered
+        if (stride <= size_t(INT32_MAX) / 8) {
+            const __m256i indices =
+                _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                   _mm256_set1_epi32(int(stride)));
+            const int* base = reinterpret_cast<const int*>(source);
+            for (; i + 8 <= count; i += 8) {
+                _mm256_storeu_si256(
+                    reinterpret_cast<__m256i*>(destination + i),
+                    _mm256_i32gather_epi32(base + (i * stride), indices, 4));
+            }
+        }
+    } else if constexpr (sizeof(T) == 8) {
+        const auto s = static_cast<long long>(stride);
+        const __m256i indices = _mm256_setr_epi64x(0, s, 2 * s, 3 * s);
+        const auto* base = reinterpret_cast<const long long*>(source);
+        for (; i + 4 <= count; i += 4) {
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i*>(destination + i),
+                _mm256_i64gather_epi64(base + (i * stride), indices, 8));
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        std::memcpy(destination + i, source + (i * stride), sizeof(T));
+    }
+}
+
+/// Copy count items from source to destination, stride items apart.
+template <typename T>
+inline void scatter(T* destination, const T* source, size_t count,
+                    size_t stride) noexcept
+{
+    // no scatter instructions before avx512, this is as fast as it gets
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(destination + (i * stride), source + i, sizeof(T));
+    }
+}
+
+/// The memory spanned by a strided slice, from its first to its last item.
+/// The strided slice must not be empty, since its data() may then be past the
+/// end of the underlying memory.
+template <typename T>
+inline slice<T> strided_span(strided_slice<T> strided) noexcept
+{
+    return raw_slice(*strided.data(),
+                     ((strided.size() - 1) * strided.stride()) + 1);
+}
+
+/// Fill size bytes at destination with copies of the sizeof(T) bytes of value,
+/// by doubling the filled region with memcpy. Once the pattern is as large as
+/// block_size it is copied as is, so the source stays in the cache.
+template <typename T>
+inline void fill_doubling(uint8_t* destination, size_t size,
+                          const T& value) noexcept
+{
+    constexpr size_t block_size = 4096 - (4096 % sizeof(T));
+    // small fixed size copies get inlined, variable sized ones are calls
+    size_t filled = 0;
+    while (filled < size && filled < 256) {
+        std::memcpy(destination + filled, &value, sizeof(T));
+        filled += sizeof(T);
+    }
+    while (filled < size && filled < block_size) {
+        const size_t amount = filled < size - filled ? filled : size - filled;
+        std::memcpy(destination + filled, destination, amount);
+        filled += amount;
+    }
+    while (filled < size) {
+        const size_t amount =
+            block_size < size - filled ? block_size : size - filled;
+        std::memcpy(destination + filled, destination, amount);
+        filled += amount;
+    }
+}
+
+#ifdef ZIGLIKE_SIMD
+/// Whether a T repeats evenly within a vector, so that a broadcast vector can
+/// be stored at any element boundary.
+template <typename T>
+constexpr bool broadcastable = simd::vec::width % sizeof(T) == 0;
+
+/// Writes 2 * width bytes of value repeated into pattern, so that loading a
+/// vector from any offset below sizeof(T) gives the pattern at that phase.
+template <typename T>
+inline void fill_pattern(uint8_t (&pattern)[2 * simd::vec::width],
+                         const T& value) noexcept
+{
+    for (size_t i = 0; i < sizeof(pattern); i += sizeof(T)) {
+        std::memcpy(pattern + i, &value, sizeof(T));
+    }
+}
+#endif
+
+/// Fill size bytes, a multiple of sizeof(T), with copies of value. If aligned
+/// is true, destination must be aligned to the vector width.
+template <typename T, bool aligned = false>
+inline void fill_trivial(uint8_t* destination, size_t size,
+                         const T& value) noexcept
+{
+    if constexpr (sizeof(T) == 1) {
+        uint8_t byte;
+        std::memcpy(&byte, &value, 1);
+        std::memset(destination, byte, size);
+        return;
+    }
+#ifdef ZIGLIKE_SIMD
+    else if constexpr (broadcastable<T>) {
+        using simd::vec;
+        uint8_t pattern[2 * vec::width];
+        fill_pattern(pattern, value);
+        const vec broadcast = vec::load(pattern);
+        const auto store = [&broadcast](uint8_t* bytes) {
+            if constexpr (aligned)
+                broadcast.store_aligned(bytes);
+            else
+                broadcast.store(bytes);
+        };
+        size_t i = 0;
+        for (; i + (4 * vec::width) <= size; i += 4 * vec::width) {
+            store(destination + i);
+            store(destination + i + vec::width);
+            store(destination + i + (2 * vec::width));
+            store(destination + i + (3 * vec::width));
+        }
+        for (; i + vec::width <= size; i += vec::width) {
+            store(destination + i);
+        }
+        // i is a multiple of sizeof(T) so the pattern is still in phase
+        std::memcpy(destination + i, pattern, size - i);
+        return;
+    }
+#endif
+    else {
+        fill_doubling(destination, size, value);
+    }
+}
+
+/// Fill size bytes, a multiple of sizeof(T), with copies of value, using
+/// non-temporal stores for everything past the first aligned address. Falls
+/// back to fill_trivial if T is not broadcastable or there is no SIMD.
+template <typename T>
+inline void fill_streaming(uint8_t* destination, size_t size,
+                           const T& value) noexcept
+{
+#ifdef ZIGLIKE_SIMD
+    if constexpr (broadcastable<T>) {
+        using simd::vec;
+        const size_t misalignment =
+            reinterpret_cast<uintptr_t>(destination) % vec::width;
+        size_t head = misalignment == 0 ? 0 : vec::width - misalignment;
+        if (head > size)
+            head = size;
+        // head may end partway through an element, which shifts the phase
+        // of the pattern used for the aligned stores
+        fill_doubling(destination, head - (head % sizeof(T)), value);
+        uint8_t pattern[2 * vec::width];
+        fill_pattern(pattern, value);
+        const size_t phase = head % sizeof(T);
+        std::memcpy(destination + head - phase, pattern, phase);
+
+        const vec broadcast = vec::load(pattern + phase);
+        size_t i = head;
+        for (; i + vec::width <= size; i += vec::width) {
+            broadcast.stream(destination + i);
+        }
+        vec::stream_fence();
+        std::memcpy(destination + i, pattern + phase, size - i);
+        return;
+    }
+#endif
+    fill_trivial(destination, size, value);
+}
+
+/// Whether T can be compared for equality by comparing its bytes, in vector
+/// lanes of sizeof(T).
+template <typename T>
+constexpr bool vector_searchable =
+    (std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>) &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+#ifdef ZIGLIKE_SIMD
+/// A vector with value repeated in every lane.
+template <typename T> inline simd::vec splat_value(const T& value) noexcept
+{
+    uint8_t pattern[2 * simd::vec::width];
+    fill_pattern(pattern, value);
+    return simd::vec::load(pattern);
+}
+
+/// Mask of the lanes in the vector at data which are equal to needle.
+template <typename T>
+inline uint64_t match_mask(const T* data, simd::vec needle) noexcept
+{
+    return simd::vec::lanes_equal<sizeof(T)>(
+               simd::vec::load(reinterpret_cast<const uint8_t*>(data)),
+               needle)
+        .mask();
+}
+#endif
+
+/// Index of the first item equal to needle, or count if there is none.
+template <typename T>
+inline size_t find_first(const T* data, size_t count, const T& needle) noexcept
+{
+    size_t i = 0;
+#ifdef ZIGLIKE_SIMD
+    if constexpr (vector_searchable<T>) {
+        using simd::vec;
+        constexpr size_t per_vec = vec::width / sizeof(T);
+        constexpr unsigned bits_per_item = vec::mask_stride * sizeof(T);
+        const vec splat = splat_value(needle);
+        for (; i + (2 * per_vec) <= count; i += 2 * per_vec) {
+            const uint64_t lo = match_mask(data + i, splat);
+            const uint64_t hi = match_mask(data + i + per_vec, splat);
+            if ((lo | hi) != 0) {
+                return lo != 0 ? i + (lowest_bit(lo) / bits_per_item)
+                               : i + per_vec + (lowest_bit(hi) / bits_per_item);
+            }
+        }
+        for (; i + per_vec <= count; i += per_vec) {
+            const uint64_t mask = match_mask(data + i, splat);
+            if (mask != 0)
+                return i + (lowest_bit(mask) / bits_per_item);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        if (data[i] == needle)
+            return i;
+    }
+    return count;
+}
+
+/// Index of the last item equal to needle, or count if there is none.
+template <typename T>
+inline size_t find_last(const T* data, size_t count, const T& needle) noexcept
+{
+    size_t i = count;
+#ifdef ZIGLIKE_SIMD
+    if constexpr (vector_searchable<T>) {
+        using simd::vec;
+        constexpr size_t per_vec = vec::width / sizeof(T);
+        constexpr unsigned bits_per_item = vec::mask_stride * sizeof(T);
+        const vec splat = splat_value(needle);
+        for (; i >= per_vec; i -= per_vec) {
+            const uint64_t mask = match_mask(data + i - per_vec, splat);
+            if (mask != 0)
+                return i - per_vec + (highest_bit(mask) / bits_per_item);
+        }
+    }
+#endif
+    while (i > 0) {
+        --i;
+        if (data[i] == needle)
+            return i;
+    }
+    return count;
+}
+
+/// Number of items equal to needle.
+template <typename T>
+inline size_t count_equal(const T* data, size_t count, const T& needle) noexcept
+{
+    size_t i = 0;
+    size_t found = 0;
+#ifdef ZIGLIKE_SIMD
+    if constexpr (vector_searchable<T>) {
+        using simd::vec;
+        constexpr size_t per_vec = vec::width / sizeof(T);
+        constexpr unsigned bits_per_item = vec::mask_stride * sizeof(T);
+        const vec splat = splat_value(needle);
+        for (; i + per_vec <= count; i += per_vec) {
+            found += count_bits(match_mask(data + i, splat)) / bits_per_item;
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        found += data[i] == needle ? 1 : 0;
+    }
+    return found;
+}
+
+/// Index of the first item equal to any of values, or count if there is none.
+template <typename T>
+inline size_t find_first_any(const T* data, size_t count, const T* values,
+                             size_t values_count) noexcept
+{
+    if (values_count == 1)
+        return find_first(data, count, values[0]);
+    size_t i = 0;
+#ifdef ZIGLIKE_SIMD
+    // past a handful of values a lookup table beats comparing each one
+    constexpr size_t max_vector_values = 8;
+    if constexpr (vector_searchable<T>) {
+        if (values_count <= max_vector_values) {
+            using simd::vec;
+            constexpr size_t per_vec = vec::width / sizeof(T);
+            constexpr unsigned bits_per_item = vec::mask_stride * sizeof(T);
+            vec splats[max_vector_values];
+            for (size_t j = 0; j < values_count; ++j) {
+                splats[j] = splat_value(values[j]);
+            }
+            for (; i + per_vec <= count; i += per_vec) {
+                const vec items =
+                    vec::load(reinterpret_cast<const uint8_t*>(data + i));
+                vec matches = vec::lanes_equal<sizeof(T)>(items, splats[0]);
+                for (size_t j = 1; j < values_count; ++j) {
+                    matches = matches |
+                              vec::lanes_equal<sizeof(T)>(items, splats[j]);
+                }
+                const uint64_t mask = matches.mask();
+                if (mask != 0)
+                    return i + (lowest_bit(mask) / bits_per_item);
+            }
+        }
+    }
+#endif
+    if constexpr (sizeof(T) == 1 && vector_searchable<T>) {
+        bool table[256] = {};
+        for (size_t j = 0; j < values_count; ++j) {
+            uint8_t byte;
+            std::memcpy(&byte, values + j, 1);
+            table[byte] = true;
+        }
+        for (; i < count; ++i) {
+            uint8_t byte;
+            std::memcpy(&byte, data + i, 1);
+            if (table[byte])
+                return i;
+        }
+        return count;
+    } else {
+        for (; i < count; ++i) {
+            for (size_t j = 0; j < values_count; ++j) {
+                if (data[i] == values[j])
+                    return i;
+            }
+        }
+        return count;
+    }
+}
+
+/// The bytes of a vector searchable type as an unsigned integer, giving a total
+/// order which is consistent with its equality.
+template <typename T> inline auto as_unsigned(const T& value) noexcept
+{
+    static_assert(vector_searchable<T>);
+    using unsigned_t = std::conditional_t<
+        sizeof(T) == 1, uint8_t,
+        std::conditional_t<
+            sizeof(T) == 2, uint16_t,
+            std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+    unsigned_t out;
+    std::memcpy(&out, &value, sizeof(T));
+    return out;
+}
+
+/// Critical factorization of needle for the Two-Way algorithm. Returns the
+/// index of the critical position and writes the period of the right half.
+template <typename T>
+inline size_t critical_factorization(const T* needle, size_t size,
+                                     size_t& period) noexcept
+{
+    // maximal suffix under both the normal and the reversed order, the larger
+    // of the two is a critical factorization. max_suffix starts at -1, and
+    // relies on unsigned wraparound
+    const auto maximal_suffix = [needle, size](bool reversed, size_t& p) {
+        size_t max_suffix = size_t(-1);
+        size_t j = 0;
+        size_t k = 1;
+        p = 1;
+        while (j + k < size) {
+            const auto a = as_unsigned(needle[j + k]);
+            const auto b = as_unsigned(needle[max_suffix + k]);
+            if (reversed ? b < a : a < b) {
+                j += k;
+                k = 1;
+                p = j - max_suffix;
+            } else if (a == b) {
+                if (k != p) {
+                    ++k;
+                } else {
+                    j += p;
+                    k = 1;
+                }
+            } else {
+                max_suffix = j++;
+                k = p = 1;
+            }
+        }
+        return max_suffix;
+    };
+
+    size_t reversed_period = 1;
+    const size_t suffix = maximal_suffix(false, period);
+    const size_t reversed_suffix = maximal_suffix(true, reversed_period);
+    if (reversed_suffix + 1 < suffix + 1)
+        return suffix + 1;
+    period = reversed_period;
+    return reversed_suffix + 1;
+}
+
+/// Two-Way string matching (Crochemore and Perrin), starting at position start
+/// of haystack. Returns the index of the first match at or after start, or
+/// haystack_size if there is none. needle_size must be at least one and no
+/// larger than haystack_size.
+template <typename T>
+inline size_t two_way(const T* haystack, size_t haystack_size,
+                      const T* needle, size_t needle_size,
+                      size_t start) noexcept
+{
+    size_t period;
+    const size_t suffix = critical_factorization(needle, needle_size, period);
+    size_t j = start;
+
+    bool periodic = true;
+    for (size_t i = 0; i < suffix; ++i) {
+        if (!(needle[i] == needle[i + period])) {
+            periodic = false;
+            break;
+        }
+    }
+
+    if (periodic) {
+        // remember how much of the left half matched the last window, so it
+        // is never compared twice
+        size_t memory = 0;
+        while (j <= haystack_size - needle_size) {
+            size_t i = suffix > memory ? suffix : memory;
+            while (i < needle_size && needle[i] == haystack[i + j])
+                ++i;
+            if (needle_size <= i) {
+                i = suffix - 1;
+                while (memory < i + 1 && needle[i] == haystack[i + j])
+                    --i;
+                if (i + 1 < memory + 1)
+                    return j;
+                j += period;
+                memory = needle_size - period;
+            } else {
+                j += i - suffix + 1;
+                memory = 0;
+            }
+        }
+    } else {
+        period = (suffix > needle_size - suffix ? suffix
+                                                : needle_size - suffix) +
+                 1;
+        while (j <= haystack_size - needle_size) {
+            size_t i = suffix;
+            while (i < needle_size && needle[i] == haystack[i + j])
+                ++i;
+            if (needle_size <= i) {
+                i = suffix - 1;
+                while (i != size_t(-1) && needle[i] == haystack[i + j])
+                    --i;
+                if (i == size_t(-1))
+                    return j;
+                j += period;
+            } else {
+                j += i - suffix + 1;
+            }
+        }
+    }
+    return haystack_size;
+}
+
+/// Index of the first occurrence of needle in haystack, or haystack_size.
+/// needle_size must be at least two and no larger than haystack_size.
+template <typename T>
+inline size_t find_sequence(const T* haystack, size_t haystack_size,
+                            const T* needle, size_t needle_size) noexcept
+{
+    size_t i = 0;
+#ifdef ZIGLIKE_SIMD
+    using simd::vec;
+    constexpr size_t per_vec = vec::width / sizeof(T);
+    constexpr unsigned bits_per_item = vec::mask_stride * sizeof(T);
+    constexpr uint64_t item_bits = (uint64_t(1) << bits_per_item) - 1;
+    const vec first = splat_value(needle[0]);
+    const vec last = splat_value(needle[needle_size - 1]);
+    const auto* const needle_bytes = reinterpret_cast<const uint8_t*>(needle);
+    const size_t verify_bytes = (needle_size - 2) * sizeof(T);
+    // bytes compared while verifying false positives. once they outweigh the
+    // bytes scanned, the prefilter is not helping and Two-Way takes over
+    size_t wasted = 0;
+    for (; i + needle_size - 1 + per_vec <= haystack_size; i += per_vec) {
+        const auto* const window =
+            reinterpret_cast<const uint8_t*>(haystack + i);
+        const vec first_matches = vec::lanes_equal<sizeof(T)>(
+            vec::load(window), first);
+        const vec last_matches = vec::lanes_equal<sizeof(T)>(
+            vec::load(window + ((needle_size - 1) * sizeof(T))), last);
+        uint64_t mask = (first_matches & last_matches).mask();
+        while (mask != 0) {
+            const unsigned item = lowest_bit(mask) / bits_per_item;
+            const size_t matched =
+                first_mismatch(window + ((item + 1) * sizeof(T)),
+                               needle_bytes + sizeof(T), verify_bytes);
+            if (matched == verify_bytes)
+                return i + item;
+            mask &= ~(item_bits << (item * bits_per_item));
+            wasted += matched + 1;
+        }
+        if (wasted > 256 + (8 * i * sizeof(T)))
+            break;
+    }
+#endif
+    return two_way(haystack, haystack_size, needle, needle_size, i);
+}
+
+#ifndef ZIGLIKE_STDMEM_NO_THREADS
+/// Splits count elements of type T into chunks for an executor. Chunks are a
+/// whole number of cache lines long, so that when the memory starts on a cache
+/// line no two tasks ever write to the same line.
+template <typename T> struct parallel_chunks
+{
+    size_t chunk_elements;
+    size_t task_count;
+
+    inline parallel_chunks(size_t count, size_t concurrency) noexcept
+    {
+        constexpr size_t cache_line = 64;
+        constexpr size_t line_gcd = [] {
+            size_t a = cache_line;
+            size_t b = sizeof(T);
+            while (b != 0) {
+                const size_t remainder = a % b;
+                a = b;
+                b = remainder;
+            }
+            return a;
+        }();
+        // smallest number of elements which is a whole number of lines
+        constexpr size_t step = cache_line / line_gcd;
+        const size_t min_elements = ZIGLIKE_PARALLEL_MIN_CHUNK / sizeof(T);
+
+        size_t elements =
+            concurrency == 0 ? count : (count + concurrency - 1) / concurrency;
+        if (elements < min_elements)
+            elements = min_elements;
+        elements = ((elements + step - 1) / step) * step;
+        chunk_elements = elements;
+        task_count = count == 0 ? 0 : (count + elements - 1) / elements;
+    }
+
+    /// The [begin, end) range of elements belonging to a task.
+    [[nodiscard]] inline size_t begin(size_t task) const noexcept
+    {
+        return task * chunk_elements;
+    }
+    [[nodiscard]] inline size_t end(size_t task, size_t count) const noexcept
+    {
+        const size_t end = (task + 1) * chunk_elements;
+        return end < count ? end : count;
+    }
+};
+#endif
+
+#ifndef ZIGLIKE_SLICE_NO_ITERATOR
+/// Whether needle occurs in segments starting at item offset of segment,
+/// possibly continuing through the following segments.
+template <typename T>
+inline bool
+joined_matches(slice<const slice<T>> segments, size_t segment, size_t offset,
+               slice<const std::remove_const_t<T>> needle) noexcept
+{
+    size_t matched = 0;
+    while (matched < needle.size()) {
+        if (segment == segments.size())
+            return false;
+        const slice<T>& current = segments.data()[segment];
+        if (offset == current.size()) {
+            ++segment;
+            offset = 0;
+            continue;
+        }
+        if (!(current.data()[offset] == needle.data()[matched]))
+            return false;
+        ++offset;
+        ++matched;
+    }
+    return true;
+}
+#endif
+} // namespace detail
 } // namespace zl
 
 template <typename T>
@@ -75,6 +1072,236 @@ inline constexpr bool zl::memcopy_lenient(zl::slice<T> destination,
     return true;
 }
 
+template <typename T, typename U, size_t N>
+inline constexpr bool zl::memcopy(zl::fixed_slice<T, N> destination,
+                                  zl::fixed_slice<U, N> source) noexcept
+{
+    static_assert(std::is_same_v<std::remove_const_t<U>, T>,
+                  "memcopy source must have the same item type as the "
+                  "destination, optionally const.");
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Cannot copy non-trivially copyable type.");
+    if (ZIGLIKE_IS_CONSTANT_EVALUATED()) {
+        for (size_t i = 0; i < N; ++i)
+            destination.data()[i] = source.data()[i];
+        return true;
+    }
+    if (memoverlaps(slice<const T>(destination), slice<const T>(source))) {
+        return false;
+    }
+    std::memcpy(destination.data(), source.data(), N * sizeof(T));
+    return true;
+}
+
+template <typename T, size_t Align>
+inline bool zl::memcopy(zl::aligned_slice<T, Align> destination,
+                        zl::aligned_slice<T, Align> source) noexcept
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Cannot copy non-trivially copyable type.");
+    if (destination.size() != source.size() ||
+        memoverlaps(slice<T>(destination), slice<T>(source))) {
+        return false;
+    }
+    constexpr bool aligned =
+#ifdef ZIGLIKE_SIMD
+        Align >= detail::simd::vec::width;
+#else
+        false;
+#endif
+    if constexpr (aligned) {
+        detail::copy_aligned(reinterpret_cast<uint8_t*>(destination.data()),
+                             reinterpret_cast<const uint8_t*>(source.data()),
+                             source.size() * sizeof(T));
+    } else {
+        // data() carries the alignment, which memcpy expansions can use
+        std::memcpy(destination.data(), source.data(),
+                    source.size() * sizeof(T));
+    }
+    return true;
+}
+
+#ifndef ZIGLIKE_SLICE_NO_ITERATOR
+template <typename T>
+inline bool zl::memcopy(zl::slice<T> destination,
+                        zl::joined_slice<T> source) noexcept
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Cannot copy non-trivially copyable type.");
+    const slice<const slice<T>> segments = source.segments();
+    size_t total = 0;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        if (memoverlaps(destination, segments.data()[i]))
+            return false;
+        total += segments.data()[i].size();
+    }
+    if (total != destination.size())
+        return false;
+
+    T* to = destination.data();
+    for (size_t i = 0; i < segments.size(); ++i) {
+        const slice<T>& segment = segments.data()[i];
+        std::memcpy(to, segment.data(), segment.size() * sizeof(T));
+        to += segment.size();
+    }
+    return true;
+}
+
+template <typename T>
+inline bool zl::memcopy(zl::joined_slice<T> destination,
+                        zl::slice<T> source) noexcept
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Cannot copy non-trivially copyable type.");
+    const slice<const slice<T>> segments = destination.segments();
+    size_t total = 0;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        if (memoverlaps(segments.data()[i], source))
+            return false;
+        total += segments.data()[i].size();
+    }
+    if (total != source.size())
+        return false;
+
+    const T* from = source.data();
+    for (size_t i = 0; i < segments.size(); ++i) {
+        const slice<T>& segment = segments.data()[i];
+        std::memcpy(segment.data(), from, segment.size() * sizeof(T));
+        from += segment.size();
+    }
+    return true;
+}
+
+template <typename T>
+inline bool zl::memcompare(zl::joined_slice<T> memory_1,
+                           zl::slice<T> memory_2) noexcept
+{
+    const slice<const slice<T>> segments = memory_1.segments();
+    size_t offset = 0;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        const slice<T>& segment = segments.data()[i];
+        if (segment.size() > memory_2.size() - offset)
+            return false;
+        if (!detail::bytes_equal(
+                reinterpret_cast<const uint8_t*>(segment.data()),
+                reinterpret_cast<const uint8_t*>(memory_2.data() + offset),
+                segment.size() * sizeof(T))) {
+            return false;
+        }
+        offset += segment.size();
+    }
+    return offset == memory_2.size();
+}
+
+template <typename T>
+inline bool zl::memcompare(zl::joined_slice<T> memory_1,
+                           zl::joined_slice<T> memory_2) noexcept
+{
+    const slice<const slice<T>> segments_1 = memory_1.segments();
+    const slice<const slice<T>> segments_2 = memory_2.segments();
+    size_t index_1 = 0;
+    size_t index_2 = 0;
+    size_t offset_1 = 0;
+    size_t offset_2 = 0;
+    while (true) {
+        // skip to the next non-empty segment of each
+        while (index_1 < segments_1.size() &&
+               offset_1 == segments_1.data()[index_1].size()) {
+            ++index_1;
+            offset_1 = 0;
+        }
+        while (index_2 < segments_2.size() &&
+               offset_2 == segments_2.data()[index_2].size()) {
+            ++index_2;
+            offset_2 = 0;
+        }
+        if (index_1 == segments_1.size() || index_2 == segments_2.size()) {
+            return index_1 == segments_1.size() &&
+                   index_2 == segments_2.size();
+        }
+
+        // compare the overlapping run of the two current segments
+        const slice<T>& segment_1 = segments_1.data()[index_1];
+        const slice<T>& segment_2 = segments_2.data()[index_2];
+        const size_t remaining_1 = segment_1.size() - offset_1;
+        const size_t remaining_2 = segment_2.size() - offset_2;
+        const size_t run =
+            remaining_1 < remaining_2 ? remaining_1 : remaining_2;
+        if (!detail::bytes_equal(
+                reinterpret_cast<const uint8_t*>(segment_1.data() + offset_1),
+                reinterpret_cast<const uint8_t*>(segment_2.data() + offset_2),
+                run * sizeof(T))) {
+            return false;
+        }
+        offset_1 += run;
+        offset_2 += run;
+    }
+}
+#endif
+
+template <typename T>
+inline bool zl::memcopy_streaming(zl::slice<T> destination,
+                                  zl::slice<T> source,
+                                  size_t threshold) noexcept
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Cannot copy non-trivially copyable type.");
+    if (destination.size() != source.size() ||
+        memoverlaps(destination, source)) {
+        return false;
+    }
+    const size_t size = source.size() * sizeof(T);
+    if (size < threshold) {
+        std::memcpy(destination.data(), source.data(), size);
+    } else {
+        detail::copy_streaming(
+            reinterpret_cast<uint8_t*>(destination.data()),
+            reinterpret_cast<const uint8_t*>(source.data()), size);
+    }
+    return true;
+}
+
+template <typename T>
+inline bool zl::memgather(zl::slice<T> destination,
+                          zl::strided_slice<T> source) noexcept
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Cannot copy non-trivially copyable type.");
+    if (destination.size() != source.size()) {
+        return false;
+    }
+    if (source.size() == 0) {
+        return true;
+    }
+    if (memoverlaps(destination, detail::strided_span(source))) {
+        return false;
+    }
+    detail::gather<std::remove_const_t<T>>(destination.data(), source.data(),
+                                           source.size(), source.stride());
+    return true;
+}
+
+template <typename T>
+inline bool zl::memscatter(zl::strided_slice<T> destination,
+                           zl::slice<T> source) noexcept
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Cannot copy non-trivially copyable type.");
+    if (destination.size() != source.size()) {
+        return false;
+    }
+    if (source.size() == 0) {
+        return true;
+    }
+    if (memoverlaps(detail::strided_span(destination), source)) {
+        return false;
+    }
+    detail::scatter<std::remove_const_t<T>>(destination.data(), source.data(),
+                                            source.size(),
+                                            destination.stride());
+    return true;
+}
+
 template <typename T>
 inline constexpr bool zl::memcompare(zl::slice<T> memory_1,
                                      zl::slice<T> memory_2) noexcept
@@ -85,18 +1312,284 @@ inline constexpr bool zl::memcompare(zl::slice<T> memory_1,
     if (memory_1.data() == memory_2.data()) {
         return true;
     }
-    const size_t size = memory_1.size() * sizeof(T);
-    const auto* const as_bytes_1 =
+    if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+        // integers have no padding, so equal values means equal bytes
+        if (ZIGLIKE_IS_CONSTANT_EVALUATED()) {
+            for (size_t i = 0; i < memory_1.size(); ++i) {
+                if (memory_1.data()[i] != memory_2.data()[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+    return detail::bytes_equal(
+        reinterpret_cast<const uint8_t*>(memory_1.data()),
+        reinterpret_cast<const uint8_t*>(memory_2.data()),
+        memory_1.size() * sizeof(T));
+}
+
+template <typename T, size_t N>
+inline constexpr bool zl::memcompare(zl::fixed_slice<T, N> memory_1,
+                                     zl::fixed_slice<T, N> memory_2) noexcept
+{
+    if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+        if (ZIGLIKE_IS_CONSTANT_EVALUATED()) {
+            for (size_t i = 0; i < N; ++i) {
+                if (memory_1.data()[i] != memory_2.data()[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+    // memcmp with a constant size is expanded inline by compilers
+    return std::memcmp(memory_1.data(), memory_2.data(), N * sizeof(T)) == 0;
+}
+
+template <typename T, size_t Align>
+inline bool zl::memcompare(zl::aligned_slice<T, Align> memory_1,
+                           zl::aligned_slice<T, Align> memory_2) noexcept
+{
+    if (memory_1.size() != memory_2.size()) {
+        return false;
+    }
+    if (memory_1.data() == memory_2.data()) {
+        return true;
+    }
+    constexpr bool aligned =
+#ifdef ZIGLIKE_SIMD
+        Align >= detail::simd::vec::width;
+#else
+        false;
+#endif
+    return detail::bytes_equal<aligned>(
+        reinterpret_cast<const uint8_t*>(memory_1.data()),
+        reinterpret_cast<const uint8_t*>(memory_2.data()),
+        memory_1.size() * sizeof(T));
+}
+
+template <typename T>
+inline constexpr zl::memorder_result
+zl::memorder(zl::slice<T> memory_1, zl::slice<T> memory_2) noexcept
+{
+    const size_t common =
+        memory_1.size() < memory_2.size() ? memory_1.size() : memory_2.size();
+    const auto by_length = [&]() -> memorder_result {
+        if (memory_1.size() == memory_2.size())
+            return {ordering::equal, common};
+        return {memory_1.size() < memory_2.size() ? ordering::less
+                                                  : ordering::greater,
+                common};
+    };
+    if (memory_1.data() == memory_2.data()) {
+        return by_length();
+    }
+
+    constexpr bool by_value = std::is_integral_v<T> || std::is_enum_v<T>;
+    const auto order_values = [](const T& a, const T& b) -> ordering {
+        if constexpr (std::is_enum_v<T>) {
+            using underlying = std::underlying_type_t<T>;
+            return underlying(a) < underlying(b) ? ordering::less
+                                                 : ordering::greater;
+        } else {
+            return a < b ? ordering::less : ordering::greater;
+        }
+    };
+
+    if constexpr (by_value) {
+        if (ZIGLIKE_IS_CONSTANT_EVALUATED()) {
+            for (size_t i = 0; i < common; ++i) {
+                if (memory_1.data()[i] != memory_2.data()[i]) {
+                    return {order_values(memory_1.data()[i],
+                                         memory_2.data()[i]),
+                            i};
+                }
+            }
+            return by_length();
+        }
+    }
+
+    const auto* const bytes_1 =
         reinterpret_cast<const uint8_t*>(memory_1.data());
-    const auto* const as_bytes_2 =
+    const auto* const bytes_2 =
         reinterpret_cast<const uint8_t*>(memory_2.data());
+    const size_t byte_index =
+        detail::first_mismatch(bytes_1, bytes_2, common * sizeof(T));
+    if (byte_index == common * sizeof(T)) {
+        return by_length();
+    }
 
-    for (size_t i = 0; i < size; ++i) {
-        if (as_bytes_1[i] != as_bytes_2[i]) {
-            return false;
+    const size_t index = byte_index / sizeof(T);
+    if constexpr (by_value) {
+        return {order_values(memory_1.data()[index], memory_2.data()[index]),
+                index};
+    } else {
+        return {bytes_1[byte_index] < bytes_2[byte_index] ? ordering::less
+                                                          : ordering::greater,
+                index};
+    }
+}
+
+template <typename T>
+inline constexpr zl::opt<size_t>
+zl::index_of_scalar(zl::slice<T> haystack,
+                    const std::remove_const_t<T>& needle) noexcept
+{
+    if (ZIGLIKE_IS_CONSTANT_EVALUATED()) {
+        for (size_t i = 0; i < haystack.size(); ++i) {
+            if (haystack.data()[i] == needle) {
+                return i;
+            }
         }
+        return {};
     }
-    return true;
+    const size_t index = detail::find_first<std::remove_const_t<T>>(
+        haystack.data(), haystack.size(), needle);
+    if (index == haystack.size()) {
+        return {};
+    }
+    return index;
+}
+
+template <typename T>
+inline constexpr zl::opt<size_t>
+zl::last_index_of_scalar(zl::slice<T> haystack,
+                         const std::remove_const_t<T>& needle) noexcept
+{
+    if (ZIGLIKE_IS_CONSTANT_EVALUATED()) {
+        for (size_t i = haystack.size(); i > 0; --i) {
+            if (haystack.data()[i - 1] == needle) {
+                return i - 1;
+            }
+        }
+        return {};
+    }
+    const size_t index = detail::find_last<std::remove_const_t<T>>(
+        haystack.data(), haystack.size(), needle);
+    if (index == haystack.size()) {
+        return {};
+    }
+    return index;
+}
+
+template <typename T>
+inline constexpr zl::opt<size_t>
+zl::index_of_any(zl::slice<T> haystack,
+                 zl::slice<const std::remove_const_t<T>> values) noexcept
+{
+    if (values.size() == 0) {
+        return {};
+    }
+    if (ZIGLIKE_IS_CONSTANT_EVALUATED()) {
+        for (size_t i = 0; i < haystack.size(); ++i) {
+            for (size_t j = 0; j < values.size(); ++j) {
+                if (haystack.data()[i] == values.data()[j]) {
+                    return i;
+                }
+            }
+        }
+        return {};
+    }
+    const size_t index = detail::find_first_any<std::remove_const_t<T>>(
+        haystack.data(), haystack.size(), values.data(), values.size());
+    if (index == haystack.size()) {
+        return {};
+    }
+    return index;
+}
+
+template <typename T>
+inline constexpr zl::opt<size_t>
+zl::index_of(zl::slice<T> haystack,
+             zl::slice<const std::remove_const_t<T>> needle) noexcept
+{
+    using item_t = std::remove_const_t<T>;
+    const size_t haystack_size = haystack.size();
+    const size_t needle_size = needle.size();
+    if (needle_size == 0) {
+        return size_t(0);
+    }
+    if (needle_size > haystack_size) {
+        return {};
+    }
+    if (needle_size == 1) {
+        return index_of_scalar(haystack, needle.data()[0]);
+    }
+
+    if constexpr (detail::vector_searchable<item_t>) {
+        if (!ZIGLIKE_IS_CONSTANT_EVALUATED()) {
+            const size_t index = detail::find_sequence<item_t>(
+                haystack.data(), haystack_size, needle.data(), needle_size);
+            if (index == haystack_size) {
+                return {};
+            }
+            return index;
+        }
+    }
+    // items which are not vector searchable, or constant evaluation
+    for (size_t i = 0; i + needle_size <= haystack_size; ++i) {
+        size_t matched = 0;
+        while (matched < needle_size &&
+               haystack.data()[i + matched] == needle.data()[matched])
+            ++matched;
+        if (matched == needle_size) {
+            return i;
+        }
+    }
+    return {};
+}
+
+#ifndef ZIGLIKE_SLICE_NO_ITERATOR
+template <typename T>
+inline zl::opt<size_t>
+zl::index_of(zl::joined_slice<T> haystack,
+             zl::slice<const std::remove_const_t<T>> needle) noexcept
+{
+    const slice<const slice<T>> segments = haystack.segments();
+    const size_t needle_size = needle.size();
+    if (needle_size == 0) {
+        return size_t(0);
+    }
+
+    // index in the joined slice of the first item of the current segment
+    size_t base = 0;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        const slice<T>& segment = segments.data()[i];
+        const size_t size = segment.size();
+        const opt<size_t> inside = index_of(segment, needle);
+        if (inside.has_value()) {
+            return base + inside.value();
+        }
+        // matches starting here would run past the end of the segment, and
+        // they all come after any match inside of it
+        const size_t first_crossing =
+            size >= needle_size ? size - needle_size + 1 : 0;
+        for (size_t start = first_crossing; start < size; ++start) {
+            if (detail::joined_matches(segments, i, start, needle)) {
+                return base + start;
+            }
+        }
+        base += size;
+    }
+    return {};
+}
+#endif
+
+template <typename T>
+inline constexpr size_t
+zl::count_scalar(zl::slice<T> haystack,
+                 const std::remove_const_t<T>& needle) noexcept
+{
+    if (ZIGLIKE_IS_CONSTANT_EVALUATED()) {
+        size_t found = 0;
+        for (size_t i = 0; i < haystack.size(); ++i) {
+            found += haystack.data()[i] == needle ? 1 : 0;
+        }
+        return found;
+    }
+    return detail::count_equal<std::remove_const_t<T>>(
+        haystack.data(), haystack.size(), needle);
 }
 
 template <typename T>
@@ -127,14 +1620,189 @@ inline constexpr void zl::memfill(zl::slice<T> slice, const T original) noexcept
     static_assert(
         std::is_nothrow_copy_constructible_v<T>,
         "Cannot memfill a type which can throw when copy constructed.");
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        if (!ZIGLIKE_IS_CONSTANT_EVALUATED()) {
+            detail::fill_trivial(reinterpret_cast<uint8_t*>(slice.data()),
+                                 slice.size() * sizeof(T), original);
+            return;
+        }
+    }
     for (T& item : slice) {
         new ((void*)std::addressof(item)) T(original);
     }
 }
 
-template <>
-inline constexpr void zl::memfill(zl::slice<uint8_t> slice,
-                                  const uint8_t original) noexcept
+template <typename T, size_t N>
+inline constexpr void zl::memfill(zl::fixed_slice<T, N> slice,
+                                  const T original) noexcept
 {
-    std::memset(slice.data(), original, slice.size());
+    static_assert(
+        std::is_nothrow_copy_constructible_v<T>,
+        "Cannot memfill a type which can throw when copy constructed.");
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        if (ZIGLIKE_IS_CONSTANT_EVALUATED()) {
+            for (size_t i = 0; i < N; ++i)
+                slice.data()[i] = original;
+        } else {
+            for (size_t i = 0; i < N; ++i)
+                std::memcpy(slice.data() + i, &original, sizeof(T));
+        }
+    } else {
+        for (T& item : slice) {
+            new ((void*)std::addressof(item)) T(original);
+        }
+    }
+}
+
+template <typename T, size_t Align>
+inline void zl::memfill(zl::aligned_slice<T, Align> slice,
+                        const T original) noexcept
+{
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        constexpr bool aligned =
+#ifdef ZIGLIKE_SIMD
+            Align >= detail::simd::vec::width;
+#else
+            false;
+#endif
+        detail::fill_trivial<T, aligned>(
+            reinterpret_cast<uint8_t*>(slice.data()), slice.size() * sizeof(T),
+            original);
+    } else {
+        memfill(zl::slice<T>(slice), original);
+    }
+}
+
+template <typename T>
+inline void zl::memfill_streaming(zl::slice<T> slice, const T original,
+                                  size_t threshold) noexcept
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Cannot stream a type which is not trivially copyable.");
+    const size_t size = slice.size() * sizeof(T);
+    auto* const bytes = reinterpret_cast<uint8_t*>(slice.data());
+    if (size < threshold) {
+        detail::fill_trivial(bytes, size, original);
+    } else {
+        detail::fill_streaming(bytes, size, original);
+    }
+}
+
+template <typename T>
+inline zl::slice<const uint8_t> zl::as_bytes(zl::slice<T> slice) noexcept
+{
+    return raw_slice(*reinterpret_cast<const uint8_t*>(slice.data()),
+                     slice.size() * sizeof(T));
+}
+
+template <typename T>
+inline zl::slice<uint8_t> zl::as_writable_bytes(zl::slice<T> slice) noexcept
+{
+    static_assert(!std::is_const_v<T>,
+                  "Cannot get writable bytes of a slice of const items.");
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Cannot write the bytes of a non-trivially copyable type.");
+    return raw_slice(*reinterpret_cast<uint8_t*>(slice.data()),
+                     slice.size() * sizeof(T));
+}
+
+template <typename T>
+inline zl::opt<zl::slice<T>> zl::bytes_as(
+    zl::slice<std::conditional_t<std::is_const_v<T>, const uint8_t, uint8_t>>
+        bytes) noexcept
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Cannot reinterpret bytes as a non-trivially copyable type.");
+    if (bytes.size() % sizeof(T) != 0 ||
+        reinterpret_cast<uintptr_t>(bytes.data()) % alignof(T) != 0) {
+        return {};
+    }
+    return raw_slice(*reinterpret_cast<T*>(bytes.data()),
+                     bytes.size() / sizeof(T));
+}
+
+#ifndef ZIGLIKE_STDMEM_NO_THREADS
+template <typename Task>
+inline void zl::thread_executor::run(size_t task_count,
+                                     const Task& task) const noexcept
+{
+    if (task_count == 0)
+        return;
+    const size_t thread_count =
+        concurrency() < task_count ? concurrency() : task_count;
+    // task i runs on thread i % thread_count, the calling thread being 0
+    const auto run_strided = [&task, task_count, thread_count](size_t first) {
+        for (size_t i = first; i < task_count; i += thread_count) {
+            task(i);
+        }
+    };
+
+    std::vector<std::thread> spawned;
+#if defined(__cpp_exceptions)
+    size_t started = 1;
+    try {
+        spawned.reserve(thread_count - 1);
+        for (; started < thread_count; ++started) {
+            spawned.emplace_back(run_strided, started);
+        }
+    } catch (...) {
+        // could not get more threads, do their work here instead
+        for (size_t i = started; i < thread_count; ++i) {
+            run_strided(i);
+        }
+    }
+#else
+    // without exceptions, failing to start a thread terminates
+    spawned.reserve(thread_count - 1);
+    for (size_t i = 1; i < thread_count; ++i) {
+        spawned.emplace_back(run_strided, i);
+    }
+#endif
+    run_strided(0);
+    for (std::thread& thread : spawned) {
+        thread.join();
+    }
+}
+
+template <typename T, typename Executor>
+inline bool zl::memcopy_parallel(zl::slice<T> destination,
+                                 zl::slice<T> source,
+                                 const Executor& executor) noexcept
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Cannot copy non-trivially copyable type.");
+    if (destination.size() != source.size() ||
+        memoverlaps(destination, source)) {
+        return false;
+    }
+    const size_t count = source.size();
+    const detail::parallel_chunks<T> chunks(count, executor.concurrency());
+    T* const to = destination.data();
+    const T* const from = source.data();
+    executor.run(chunks.task_count, [&chunks, to, from, count](size_t task) {
+        const size_t begin = chunks.begin(task);
+        std::memcpy(to + begin, from + begin,
+                    (chunks.end(task, count) - begin) * sizeof(T));
+    });
+    return true;
+}
+
+template <typename T, typename Executor>
+inline void zl::memfill_parallel(zl::slice<T> slice, const T original,
+                                 const Executor& executor) noexcept
+{
+    static_assert(
+        std::is_nothrow_copy_constructible_v<T>,
+        "Cannot memfill a type which can throw when copy constructed.");
+    const size_t count = slice.size();
+    const detail::parallel_chunks<T> chunks(count, executor.concurrency());
+    T* const data = slice.data();
+    executor.run(chunks.task_count,
+                 [&chunks, &original, data, count](size_t task) {
+                     const size_t begin = chunks.begin(task);
+                     memfill(raw_slice(data[begin],
+                                       chunks.end(task, count) - begin),
+                             original);
+                 });
 }
+#endif
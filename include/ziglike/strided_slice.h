@@ -0,0 +1,317 @@
+#pragma once
+#include "ziglike/detail/abort.h"
+#include "ziglike/detail/bounds_check.h"
+#include "ziglike/slice.h"
+
+#ifndef ZIGLIKE_SLICE_NO_ITERATOR
+#include <iterator>
+#endif
+
+#ifndef ZIGLIKE_NOEXCEPT
+#define ZIGLIKE_NOEXCEPT noexcept
+#endif
+
+namespace zl {
+/// A non-owning reference to every stride-th item of a contiguously allocated
+/// array of type T, for example a column of a row-major matrix or one channel
+/// of interleaved audio. Like slice, it is never null and is intended to be
+/// passed around like a pointer.
+template <typename T> class strided_slice
+{
+  private:
+    T* m_data;
+    size_t m_elements;
+    size_t m_stride;
+
+    using TNonConst = std::remove_const_t<T>;
+
+    template <typename U> friend class strided_slice;
+
+    /// source.data() + offset, after aborting if the arguments are invalid,
+    /// so that the pointer is never formed past the end of source.
+    [[nodiscard]] static inline constexpr T*
+    checked_data(slice<T> source, size_t offset, size_t stride) ZIGLIKE_NOEXCEPT
+    {
+        if (stride == 0 || offset > source.size()) [[unlikely]]
+            ZIGLIKE_ABORT();
+        return source.data() + offset;
+    }
+
+  public:
+    using type = T;
+    using value_type = T;
+
+    /// Reference source[offset], source[offset + stride], and so on until the
+    /// end of source. Aborts if stride is zero or offset is greater than the
+    /// size of source.
+    inline constexpr strided_slice(slice<T> source, size_t offset,
+                                   size_t stride) ZIGLIKE_NOEXCEPT
+        : m_data(checked_data(source, offset, stride)),
+          m_elements(offset < source.size()
+                         ? ((source.size() - offset - 1) / stride) + 1
+                         : 0),
+          m_stride(stride)
+    {
+    }
+
+    /// A strided slice of const items can always be made from a nonconst one
+    template <typename U>
+    inline constexpr strided_slice(
+        const strided_slice<U>& other,
+        std::enable_if_t<std::is_const_v<T> && std::is_same_v<U, TNonConst>,
+                         int> = 0) ZIGLIKE_NOEXCEPT
+        : m_data(other.m_data),
+          m_elements(other.m_elements),
+          m_stride(other.m_stride)
+    {
+    }
+
+    /// Every slice is also a strided slice with a stride of one
+    inline constexpr strided_slice(slice<T> source) ZIGLIKE_NOEXCEPT
+        : m_data(source.data()),
+          m_elements(source.size()),
+          m_stride(1)
+    {
+    }
+
+    strided_slice() = delete;
+
+    /// Pointer to the first item. Guaranteed to not be null.
+    [[nodiscard]] inline constexpr T* data() const ZIGLIKE_NOEXCEPT
+    {
+        return m_data;
+    }
+    /// Number of items referenced, not the size of the underlying memory.
+    [[nodiscard]] inline constexpr size_t size() const ZIGLIKE_NOEXCEPT
+    {
+        return m_elements;
+    }
+    /// Distance between consecutive items, in items.
+    [[nodiscard]] inline constexpr size_t stride() const ZIGLIKE_NOEXCEPT
+    {
+        return m_stride;
+    }
+
+    /// Access the item at index. Bounds checked according to
+    /// ZIGLIKE_BOUNDS_CHECK, like slice::operator[].
+    [[nodiscard]] inline constexpr T&
+    operator[](size_t index) const ZIGLIKE_NOEXCEPT
+    {
+#ifdef ZIGLIKE_BOUNDS_CHECKED
+        if (index >= m_elements) [[unlikely]]
+            ZIGLIKE_ABORT();
+#endif
+        return m_data[index * m_stride];
+    }
+
+    /// Access the item at index, or null if index is out of bounds.
+    template <typename U = T>
+    [[nodiscard]] inline constexpr opt<U&>
+    at(size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        if (index >= m_elements)
+            return {};
+        return m_data[index * m_stride];
+    }
+
+    /// Access the item at index without ever checking bounds.
+    [[nodiscard]] inline constexpr T&
+    unchecked_at(size_t index) const ZIGLIKE_NOEXCEPT
+    {
+        return m_data[index * m_stride];
+    }
+
+    inline constexpr friend bool
+    operator==(const strided_slice& a, const strided_slice& b) ZIGLIKE_NOEXCEPT
+    {
+        return a.m_data == b.m_data && a.m_elements == b.m_elements &&
+               a.m_stride == b.m_stride;
+    }
+
+    inline constexpr friend bool
+    operator!=(const strided_slice& a, const strided_slice& b) ZIGLIKE_NOEXCEPT
+    {
+        return !(a == b);
+    }
+
+#ifndef ZIGLIKE_SLICE_NO_ITERATOR
+    /// Random access iterator which steps over stride items at a time. It
+    /// stores an index rather than a pointer, and compares indices, so that a
+    /// pointer is only formed when an item is dereferenced. The end iterator,
+    /// and every iterator of an empty strided slice, never points past the
+    /// end of the underlying memory.
+    template <typename U> struct basic_iterator
+    {
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::remove_cv_t<U>;
+        using pointer = U*;
+        using reference = U&;
+
+        inline constexpr basic_iterator() ZIGLIKE_NOEXCEPT = default;
+
+        inline constexpr basic_iterator(pointer data, size_t index,
+                                        size_t stride) ZIGLIKE_NOEXCEPT
+            : m_data(data),
+              m_index(index),
+              m_stride(stride)
+        {
+        }
+
+        /// A mutable iterator can always be converted to a const iterator
+        template <typename MaybeU = U>
+        inline constexpr basic_iterator(
+            std::enable_if_t<std::is_const_v<MaybeU>,
+                             const basic_iterator<TNonConst>&>
+                other) ZIGLIKE_NOEXCEPT : m_data(other.m_data),
+                                          m_index(other.m_index),
+                                          m_stride(other.m_stride)
+        {
+        }
+
+        inline constexpr reference operator*() const ZIGLIKE_NOEXCEPT
+        {
+            return m_data[m_index * m_stride];
+        }
+
+        inline constexpr pointer operator->() const ZIGLIKE_NOEXCEPT
+        {
+            return m_data + m_index * m_stride;
+        }
+
+        inline constexpr reference
+        operator[](difference_type offset) const ZIGLIKE_NOEXCEPT
+        {
+            return m_data[(m_index + offset) * m_stride];
+        }
+
+        // Prefix increment
+        inline constexpr basic_iterator& operator++() ZIGLIKE_NOEXCEPT
+        {
+            ++m_index;
+            return *this;
+        }
+
+        // Postfix increment
+        // NOLINTNEXTLINE
+        inline constexpr basic_iterator operator++(int) ZIGLIKE_NOEXCEPT
+        {
+            basic_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        // Prefix decrement
+        inline constexpr basic_iterator& operator--() ZIGLIKE_NOEXCEPT
+        {
+            --m_index;
+            return *this;
+        }
+
+        // Postfix decrement
+        // NOLINTNEXTLINE
+        inline constexpr basic_iterator operator--(int) ZIGLIKE_NOEXCEPT
+        {
+            basic_iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        inline constexpr basic_iterator&
+        operator+=(difference_type offset) ZIGLIKE_NOEXCEPT
+        {
+            m_index += offset;
+            return *this;
+        }
+
+        inline constexpr basic_iterator&
+        operator-=(difference_type offset) ZIGLIKE_NOEXCEPT
+        {
+            m_index -= offset;
+            return *this;
+        }
+
+        inline constexpr friend basic_iterator
+        operator+(basic_iterator iter, difference_type offset) ZIGLIKE_NOEXCEPT
+        {
+            return iter += offset;
+        }
+
+        inline constexpr friend basic_iterator
+        operator+(difference_type offset, basic_iterator iter) ZIGLIKE_NOEXCEPT
+        {
+            return iter += offset;
+        }
+
+        inline constexpr friend basic_iterator
+        operator-(basic_iterator iter, difference_type offset) ZIGLIKE_NOEXCEPT
+        {
+            return iter -= offset;
+        }
+
+        inline constexpr friend difference_type
+        operator-(const basic_iterator& a,
+                  const basic_iterator& b) ZIGLIKE_NOEXCEPT
+        {
+            return difference_type(a.m_index) - difference_type(b.m_index);
+        }
+
+        inline constexpr friend bool
+        operator==(const basic_iterator& a,
+                   const basic_iterator& b) ZIGLIKE_NOEXCEPT
+        {
+            return a.m_index == b.m_index;
+        };
+        inline constexpr friend bool
+        operator!=(const basic_iterator& a,
+                   const basic_iterator& b) ZIGLIKE_NOEXCEPT
+        {
+            return a.m_index != b.m_index;
+        };
+        inline constexpr friend bool
+        operator<(const basic_iterator& a,
+                  const basic_iterator& b) ZIGLIKE_NOEXCEPT
+        {
+            return a.m_index < b.m_index;
+        };
+        inline constexpr friend bool
+        operator>(const basic_iterator& a,
+                  const basic_iterator& b) ZIGLIKE_NOEXCEPT
+        {
+            return a.m_index > b.m_index;
+        };
+        inline constexpr friend bool
+        operator<=(const basic_iterator& a,
+                   const basic_iterator& b) ZIGLIKE_NOEXCEPT
+        {
+            return a.m_index <= b.m_index;
+        };
+        inline constexpr friend bool
+        operator>=(const basic_iterator& a,
+                   const basic_iterator& b) ZIGLIKE_NOEXCEPT
+        {
+            return a.m_index >= b.m_index;
+        };
+
+      private:
+        template <typename> friend struct basic_iterator;
+
+        pointer m_data = nullptr;
+        size_t m_index = 0;
+        size_t m_stride = 1;
+    };
+
+    using iterator = basic_iterator<T>;
+    using const_iterator = basic_iterator<const T>;
+
+    inline constexpr iterator begin() const ZIGLIKE_NOEXCEPT
+    {
+        return iterator(m_data, 0, m_stride);
+    }
+    inline constexpr iterator end() const ZIGLIKE_NOEXCEPT
+    {
+        return iterator(m_data, m_elements, m_stride);
+    }
+#endif
+};
+} // namespace zl
@@ -0,0 +1,100 @@
+#include "test_header.h"
+// test header must be first
+#include "ziglike/aligned_slice.h"
+#include "ziglike/stdmem.h"
+#include <array>
+
+using namespace zl;
+
+static_assert(aligned_slice<float, 64>::alignment == 64);
+static_assert(
+    std::is_convertible_v<aligned_slice<int, 64>, aligned_slice<int, 16>>,
+    "aligned slices should convert to lower alignments");
+static_assert(
+    !std::is_convertible_v<aligned_slice<int, 16>, aligned_slice<int, 64>>,
+    "aligned slices should not convert to higher alignments");
+static_assert(std::is_convertible_v<aligned_slice<int, 64>,
+                                    aligned_slice<const int, 64>>);
+static_assert(std::is_convertible_v<aligned_slice<int, 64>, slice<int>>);
+static_assert(std::is_convertible_v<aligned_slice<int, 64>, slice<const int>>);
+static_assert(!std::is_convertible_v<slice<int>, aligned_slice<int, 64>>,
+              "alignment should only be asserted explicitly");
+
+TEST_SUITE("aligned_slice")
+{
+    TEST_CASE("construction and access")
+    {
+        SUBCASE("alignment is checked")
+        {
+            alignas(64) std::array<uint32_t, 64> mem = {};
+            slice<uint32_t> ints(mem);
+            REQUIRE(aligned_slice<uint32_t, 64>::is_aligned(ints));
+            REQUIRE(!aligned_slice<uint32_t, 64>::is_aligned(
+                ints.drop_front(1)));
+
+            aligned_slice<uint32_t, 64> aligned(ints);
+            REQUIRE(aligned.data() == mem.data());
+            REQUIRE(aligned.size() == 64);
+            REQUIREABORTS((aligned_slice<uint32_t, 64>(ints.drop_front(1))));
+            // 16 bytes in is still aligned to 16
+            aligned_slice<uint32_t, 16> lesser(ints.drop_front(4));
+            REQUIRE(lesser.data() == &mem[4]);
+        }
+
+        SUBCASE("access")
+        {
+            alignas(32) std::array<int, 8> mem = {0, 1, 2, 3, 4, 5, 6, 7};
+            aligned_slice<int, 32> ints((slice<int>(mem)));
+
+            REQUIRE(ints[3] == 3);
+            ints[3] = 30;
+            REQUIRE(mem[3] == 30);
+            REQUIRE(&ints.at(7).value() == &mem[7]);
+            REQUIRE(!ints.at(8).has_value());
+            REQUIRE(&ints.unchecked_at(2) == &mem[2]);
+#ifdef ZIGLIKE_BOUNDS_CHECKED
+            REQUIREABORTS((void)ints[8]);
+#endif
+            REQUIRE(ints.first(4).size() == 4);
+            REQUIRE(ints.first(4).data() == mem.data());
+            REQUIREABORTS((void)ints.first(9));
+
+            int sum = 0;
+            for (int item : ints)
+                sum += item;
+            REQUIRE(sum == 0 + 1 + 2 + 30 + 4 + 5 + 6 + 7);
+
+            slice<const int> dynamic = ints;
+            REQUIRE(dynamic.size() == 8);
+        }
+    }
+
+    TEST_CASE("stdmem")
+    {
+        SUBCASE("memcopy, memcompare, and memfill")
+        {
+            for (size_t count : {0, 1, 7, 16, 33, 100, 257}) {
+                alignas(64) std::array<uint16_t, 257> a_mem = {};
+                alignas(64) std::array<uint16_t, 257> b_mem = {};
+                aligned_slice<uint16_t, 64> a(slice<uint16_t>(a_mem, 0, count));
+                aligned_slice<uint16_t, 64> b(slice<uint16_t>(b_mem, 0, count));
+
+                memfill(a, uint16_t(0x1234));
+                for (size_t i = 0; i < a_mem.size(); ++i)
+                    REQUIRE(a_mem[i] == (i < count ? 0x1234 : 0));
+                REQUIRE(memcompare(a, b) == (count == 0));
+                REQUIRE(memcopy(b, a));
+                REQUIRE(memcompare(a, b));
+                if (count > 0) {
+                    b_mem[count - 1] = 0;
+                    REQUIRE(!memcompare(a, b));
+                }
+            }
+
+            alignas(64) std::array<uint8_t, 128> mem = {};
+            aligned_slice<uint8_t, 64> whole((slice<uint8_t>(mem)));
+            REQUIRE(!memcopy(whole.first(64), whole.first(64)));
+            REQUIRE(!memcopy(whole.first(64), whole.first(32)));
+        }
+    }
+}
@@ -0,0 +1,172 @@
+#include "test_header.h"
+// test header must be first
+#include "ziglike/fixed_slice.h"
+#include "ziglike/stdmem.h"
+#include <array>
+
+using namespace zl;
+
+static_assert(sizeof(fixed_slice<int, 16>) == sizeof(int*),
+              "fixed_slice should be pointer sized");
+static_assert(!std::is_default_constructible_v<fixed_slice<int, 4>>,
+              "fixed_slice should not be default constructible");
+static_assert(std::is_convertible_v<fixed_slice<int, 4>, slice<int>>);
+static_assert(std::is_convertible_v<fixed_slice<int, 4>, slice<const int>>);
+static_assert(!std::is_convertible_v<fixed_slice<const int, 4>, slice<int>>);
+static_assert(
+    std::is_convertible_v<fixed_slice<int, 4>, fixed_slice<const int, 4>>);
+static_assert(!std::is_convertible_v<slice<int>, fixed_slice<int, 4>>,
+              "conversion from a runtime sized slice should be explicit");
+
+// constant evaluation of the stdmem overloads is promised wherever it can be
+// detected
+#if defined(__cpp_lib_is_constant_evaluated) || defined(__GNUC__) ||          \
+    defined(__clang__)
+#ifndef ZIGLIKE_HAS_CONSTANT_EVALUATED
+#error "constant evaluation should be detected by this compiler"
+#endif
+#endif
+
+#ifdef ZIGLIKE_HAS_CONSTANT_EVALUATED
+constexpr int copy_in_constexpr()
+{
+    int source[4] = {1, 2, 3, 4};
+    int destination[4] = {};
+    memcopy(fixed_slice<int, 4>(destination), fixed_slice<int, 4>(source));
+    const int constants[4] = {5, 6, 7, 8};
+    int from_constants[4] = {};
+    memcopy(fixed_slice<int, 4>(from_constants),
+            fixed_slice<const int, 4>(constants));
+    memfill(fixed_slice<int, 4>(source), 7);
+    return destination[3] + source[0] + from_constants[0];
+}
+static_assert(copy_in_constexpr() == 16);
+
+constexpr bool compare_in_constexpr()
+{
+    int a[3] = {1, 2, 3};
+    int b[3] = {1, 2, 3};
+    int c[3] = {1, 2, 4};
+    return memcompare(fixed_slice<int, 3>(a), fixed_slice<int, 3>(b)) &&
+           !memcompare(fixed_slice<int, 3>(a), fixed_slice<int, 3>(c));
+}
+static_assert(compare_in_constexpr());
+#endif
+
+TEST_SUITE("fixed_slice")
+{
+    TEST_CASE("construction and access")
+    {
+        SUBCASE("construction")
+        {
+            int c_array[4] = {0, 1, 2, 3};
+            std::array<int, 4> std_array = {4, 5, 6, 7};
+            const std::array<int, 4> const_array = {8, 9, 10, 11};
+
+            fixed_slice<int, 4> from_c(c_array);
+            fixed_slice<int, 4> from_std(std_array);
+            fixed_slice<const int, 4> from_const(const_array);
+            REQUIRE(from_c.data() == c_array);
+            REQUIRE(from_std.data() == std_array.data());
+            REQUIRE(from_const.data() == const_array.data());
+            static_assert(fixed_slice<int, 4>::size() == 4);
+            static_assert(fixed_slice<int, 4>::extent == 4);
+
+            slice<int> dynamic(std_array);
+            fixed_slice<int, 4> from_dynamic(dynamic);
+            REQUIRE(from_dynamic == from_std);
+            REQUIREABORTS((fixed_slice<int, 3>(dynamic)));
+
+            fixed_slice<int, 2> raw = raw_fixed_slice<2>(c_array[1]);
+            REQUIRE(raw.data() == &c_array[1]);
+        }
+
+        SUBCASE("conversion and access")
+        {
+            std::array<int, 6> mem = {0, 1, 2, 3, 4, 5};
+            fixed_slice<int, 6> ints(mem);
+
+            slice<int> dynamic = ints;
+            REQUIRE(dynamic.size() == 6);
+            REQUIRE(dynamic.data() == mem.data());
+            slice<const int> const_dynamic = ints;
+            REQUIRE(const_dynamic.data() == mem.data());
+
+            REQUIRE(ints[4] == 4);
+            ints[4] = 40;
+            REQUIRE(mem[4] == 40);
+            REQUIRE(&ints.at(5).value() == &mem[5]);
+            REQUIRE(!ints.at(6).has_value());
+            REQUIRE(&ints.unchecked_at(1) == &mem[1]);
+#ifdef ZIGLIKE_BOUNDS_CHECKED
+            REQUIREABORTS((void)ints[6]);
+#endif
+
+            int sum = 0;
+            for (int item : ints)
+                sum += item;
+            REQUIRE(sum == 0 + 1 + 2 + 3 + 40 + 5);
+        }
+
+        SUBCASE("subslicing")
+        {
+            std::array<int, 6> mem = {0, 1, 2, 3, 4, 5};
+            fixed_slice<int, 6> ints(mem);
+
+            fixed_slice<int, 2> front = ints.first<2>();
+            fixed_slice<int, 3> back = ints.last<3>();
+            fixed_slice<int, 2> middle = ints.subslice<2, 4>();
+            REQUIRE(front.data() == &mem[0]);
+            REQUIRE(back.data() == &mem[3]);
+            REQUIRE(middle.data() == &mem[2]);
+            REQUIRE(ints.subslice<6, 6>().size() == 0);
+        }
+
+        SUBCASE("chunks")
+        {
+            std::array<uint8_t, 10> mem = {};
+            slice<uint8_t> bytes(mem);
+            size_t count = 0;
+            for (auto chunk : bytes.chunks<4>()) {
+                static_assert(
+                    std::is_same_v<decltype(chunk), fixed_slice<uint8_t, 4>>);
+                memfill(chunk, uint8_t(count + 1));
+                ++count;
+            }
+            REQUIRE(count == 2);
+            REQUIRE(mem == std::array<uint8_t, 10>{1, 1, 1, 1, 2, 2, 2, 2, 0,
+                                                   0});
+        }
+    }
+
+    TEST_CASE("stdmem")
+    {
+        SUBCASE("memcopy, memcompare, and memfill")
+        {
+            std::array<uint32_t, 8> a = {};
+            std::array<uint32_t, 8> b = {};
+            fixed_slice<uint32_t, 8> a_slice(a);
+            fixed_slice<uint32_t, 8> b_slice(b);
+
+            memfill(a_slice, 0xABCDEFU);
+            for (uint32_t item : a)
+                REQUIRE(item == 0xABCDEFU);
+            REQUIRE(!memcompare(a_slice, b_slice));
+            REQUIRE(memcopy(b_slice, a_slice));
+            REQUIRE(memcompare(a_slice, b_slice));
+            REQUIRE(memcompare(fixed_slice<const uint32_t, 8>(a_slice),
+                               fixed_slice<const uint32_t, 8>(b_slice)));
+
+            // overlapping copies are refused, like memcopy on slices
+            REQUIRE(!memcopy(a_slice.first<4>(), a_slice.subslice<2, 6>()));
+
+            // copying from const items
+            const std::array<uint32_t, 8> constants = {1, 2, 3, 4, 5, 6, 7, 8};
+            fixed_slice<const uint32_t, 8> const_slice(constants);
+            REQUIRE(memcopy(b_slice, const_slice));
+            REQUIRE(b[7] == 8);
+            REQUIRE(!memcopy(fixed_slice<uint32_t, 8>(b),
+                             fixed_slice<const uint32_t, 8>(b_slice)));
+        }
+    }
+}
@@ -0,0 +1,176 @@
+#include "test_header.h"
+// test header must be first
+#include "ziglike/io.h"
+#include "ziglike/stdmem.h"
+#include <array>
+#include <cstdio>
+#include <vector>
+
+using namespace zl;
+
+TEST_SUITE("io")
+{
+    TEST_CASE("writev and readv")
+    {
+        SUBCASE("through a pipe")
+        {
+            int fds[2];
+            REQUIRE(::pipe(fds) == 0);
+
+            std::array<uint8_t, 5> header = {'h', 'e', 'a', 'd', ':'};
+            std::array<uint8_t, 4> body = {'b', 'o', 'd', 'y'};
+            std::array<slice<const uint8_t>, 4> parts = {
+                slice<const uint8_t>(header), slice<const uint8_t>(body, 0, 0),
+                slice<const uint8_t>(body), slice<const uint8_t>(header)};
+
+            auto written = zl::writev(
+                fds[1], slice<const slice<const uint8_t>>(parts));
+            REQUIRE(written.okay());
+            REQUIRE(written.release() == 14);
+
+            std::array<uint8_t, 3> first = {};
+            std::array<uint8_t, 20> second = {};
+            std::array<slice<uint8_t>, 2> destinations = {
+                slice<uint8_t>(first), slice<uint8_t>(second)};
+            auto read = zl::readv(
+                fds[0], slice<const slice<uint8_t>>(destinations));
+            REQUIRE(read.okay());
+            // stops after the short read, instead of blocking
+            REQUIRE(read.release() == 14);
+            REQUIRE(first[2] == 'a');
+            REQUIRE(second[0] == 'd');
+            REQUIRE(second[2] == 'b');
+            REQUIRE(second[10] == ':');
+
+            ::close(fds[1]);
+            auto eof = zl::readv(
+                fds[0], slice<const slice<uint8_t>>(destinations));
+            REQUIRE(eof.okay());
+            REQUIRE(eof.release() == 0);
+            ::close(fds[0]);
+        }
+
+        SUBCASE("more segments than IOV_MAX")
+        {
+            std::FILE* file = std::tmpfile();
+            REQUIRE(file != nullptr);
+            const int fd = ::fileno(file);
+
+            const size_t count = detail::iov_batch * 2 + 7;
+            std::vector<uint8_t> source(count);
+            for (size_t i = 0; i < count; ++i)
+                source[i] = uint8_t(i * 7);
+            std::vector<slice<const uint8_t>> parts;
+            for (size_t i = 0; i < count; ++i)
+                parts.push_back(slice<const uint8_t>(source, i, i + 1));
+
+            auto written = zl::writev(
+                fd, slice<const slice<const uint8_t>>(parts));
+            REQUIRE(written.okay());
+            REQUIRE(written.release() == count);
+
+            // read it back into two byte segments, skipping the first byte
+            std::vector<uint8_t> destination(count - 1);
+            std::vector<slice<uint8_t>> destinations;
+            for (size_t i = 0; i < destination.size(); i += 2) {
+                destinations.push_back(slice<uint8_t>(
+                    destination, i, std::min(i + 2, destination.size())));
+            }
+            auto read = zl::preadv(
+                fd, slice<const slice<uint8_t>>(destinations), 1);
+            REQUIRE(read.okay());
+            REQUIRE(read.release() == count - 1);
+            REQUIRE(memcompare(slice<const uint8_t>(destination),
+                               slice<const uint8_t>(source, 1, count)));
+            std::fclose(file);
+        }
+
+        SUBCASE("nonblocking pipe with more segments than IOV_MAX")
+        {
+            int fds[2];
+            REQUIRE(::pipe(fds) == 0);
+            REQUIRE(::fcntl(fds[0], F_SETFL, O_NONBLOCK) == 0);
+            REQUIRE(::fcntl(fds[1], F_SETFL, O_NONBLOCK) == 0);
+
+            const std::vector<uint8_t> source(detail::iov_batch, 'x');
+            REQUIRE(::write(fds[1], source.data(), source.size()) ==
+                    ssize_t(source.size()));
+
+            // the first batch fills exactly, and the second would block
+            std::vector<uint8_t> destination(detail::iov_batch * 2);
+            std::vector<slice<uint8_t>> destinations;
+            for (size_t i = 0; i < destination.size(); ++i)
+                destinations.push_back(slice<uint8_t>(destination, i, i + 1));
+            auto read = zl::readv(
+                fds[0], slice<const slice<uint8_t>>(destinations));
+            REQUIRE(read.okay());
+            REQUIRE(read.release() == detail::iov_batch);
+            REQUIRE(destination[detail::iov_batch - 1] == 'x');
+
+            auto empty = zl::readv(
+                fds[0], slice<const slice<uint8_t>>(destinations));
+            REQUIRE(empty.err() == io_error::WouldBlock);
+
+            // fill the pipe until writev stops partway through
+            const std::vector<uint8_t> chunk(1 << 16, 'y');
+            std::vector<slice<const uint8_t>> parts(
+                detail::iov_batch * 2, slice<const uint8_t>(chunk));
+            auto written = zl::writev(
+                fds[1], slice<const slice<const uint8_t>>(parts));
+            REQUIRE(written.okay());
+            const size_t total = written.release();
+            REQUIRE(total != 0);
+            REQUIRE(total < chunk.size() * parts.size());
+
+            auto full = zl::writev(
+                fds[1], slice<const slice<const uint8_t>>(parts));
+            REQUIRE(full.err() == io_error::WouldBlock);
+            ::close(fds[0]);
+            ::close(fds[1]);
+        }
+
+        SUBCASE("blocking pipe stops after the first batch")
+        {
+            int fds[2];
+            REQUIRE(::pipe(fds) == 0);
+            const std::vector<uint8_t> source(detail::iov_batch + 1, 'z');
+            REQUIRE(::write(fds[1], source.data(), source.size()) ==
+                    ssize_t(source.size()));
+
+            std::vector<uint8_t> destination(detail::iov_batch * 2);
+            std::vector<slice<uint8_t>> destinations;
+            for (size_t i = 0; i < destination.size(); ++i)
+                destinations.push_back(slice<uint8_t>(destination, i, i + 1));
+            auto read = zl::readv(
+                fds[0], slice<const slice<uint8_t>>(destinations));
+            REQUIRE(read.okay());
+            REQUIRE(read.release() == detail::iov_batch);
+            ::close(fds[0]);
+            ::close(fds[1]);
+        }
+
+        SUBCASE("errors")
+        {
+            std::array<uint8_t, 4> mem = {};
+            std::array<slice<uint8_t>, 1> destinations = {
+                slice<uint8_t>(mem)};
+            std::array<slice<const uint8_t>, 1> parts = {
+                slice<const uint8_t>(mem)};
+
+            auto bad_read = zl::readv(
+                -1, slice<const slice<uint8_t>>(destinations));
+            REQUIRE(bad_read.err() == io_error::BadFileDescriptor);
+            auto bad_write = zl::writev(
+                -1, slice<const slice<const uint8_t>>(parts));
+            REQUIRE(bad_write.err() == io_error::BadFileDescriptor);
+
+            int fds[2];
+            REQUIRE(::pipe(fds) == 0);
+            auto unseekable = zl::preadv(
+                fds[0], slice<const slice<uint8_t>>(destinations), 0);
+            REQUIRE(unseekable.err() == io_error::Unseekable);
+            ::close(fds[0]);
+            ::close(fds[1]);
+        }
+    }
+}
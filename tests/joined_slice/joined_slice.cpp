@@ -20,6 +20,7 @@ static_assert(!std::is_constructible_v<zl::joined_slice<int>,
                                        zl::joined_slice<const int>>);
 static_assert(!std::is_constructible_v<zl::joined_slice<int>,
                                        zl::slice<zl::slice<const int>>>);
+static_assert(std::is_copy_constructible_v<zl::joined_slice<int>>);
 
 TEST_SUITE("joined_slice")
 {
@@ -74,5 +75,92 @@ TEST_SUITE("joined_slice")
             }
             REQUIRE(count == mem.size() * slices.size());
         }
+
+        SUBCASE("conversion to const")
+        {
+            std::array<int, 4> mem{0, 1, 2, 3};
+            std::array<zl::slice<int>, 2> slices = {mem, mem};
+            zl::joined_slice<int> ints(slices);
+            zl::joined_slice<const int> const_ints(ints);
+
+            REQUIRE(const_ints.segments().size() == 2);
+            REQUIRE(const_ints.segments().data()[1].data() == mem.data());
+            REQUIRE(const_ints.size() == 8);
+        }
+
+        SUBCASE("empty segments are skipped")
+        {
+            std::array<int, 6> mem{0, 1, 2, 3, 4, 5};
+            zl::slice<int> all(mem);
+            std::array<zl::slice<int>, 6> slices = {
+                all.first(0),      all.subslice(0, 2), all.subslice(2, 2),
+                all.subslice(2, 3), all.drop_front(3), all.last(0)};
+            zl::joined_slice<int> ints(slices);
+
+            int expected = 0;
+            for (int i : ints) {
+                REQUIRE(i == expected);
+                ++expected;
+            }
+            REQUIRE(expected == 6);
+
+            std::array<zl::slice<int>, 2> empty = {all.first(0), all.last(0)};
+            zl::joined_slice<int> nothing(empty);
+            REQUIRE(nothing.begin() == nothing.end());
+            REQUIRE(nothing.size() == 0);
+        }
+
+        SUBCASE("for_each_segment")
+        {
+            std::array<int, 10> mem{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+            zl::slice<int> all(mem);
+            std::array<zl::slice<int>, 3> slices = {
+                all.first(3), all.subslice(3, 3), all.drop_front(3)};
+            zl::joined_slice<int> ints(slices);
+
+            size_t calls = 0;
+            int sum = 0;
+            ints.for_each_segment([&](zl::slice<int> segment) {
+                ++calls;
+                for (int i : segment)
+                    sum += i;
+            });
+            REQUIRE(calls == 2);
+            REQUIRE(sum == 45);
+            REQUIRE(ints.segments().size() == 3);
+        }
+
+        SUBCASE("random access through an index")
+        {
+            std::array<int, 10> mem{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+            zl::slice<int> all(mem);
+            std::array<zl::slice<int>, 5> slices = {
+                all.first(1), all.subslice(1, 1), all.subslice(1, 5),
+                all.subslice(5, 5), all.drop_front(5)};
+            zl::joined_slice<int> ints(slices);
+
+            std::array<size_t, 6> offsets;
+            zl::indexed_joined_slice<int> indexed =
+                ints.build_index(offsets);
+            REQUIRE(offsets[0] == 0);
+            REQUIRE(offsets[2] == 1);
+            REQUIRE(offsets[5] == 10);
+            REQUIRE(indexed.size() == 10);
+
+            for (size_t i = 0; i < mem.size(); ++i) {
+                REQUIRE(&indexed[i] == &mem[i]);
+                REQUIRE(&indexed.at(i).value() == &mem[i]);
+                REQUIRE(&indexed.unchecked_at(i) == &mem[i]);
+            }
+            REQUIRE(!indexed.at(10).has_value());
+#ifdef ZIGLIKE_BOUNDS_CHECKED
+            REQUIREABORTS((void)indexed[10]);
+#endif
+            indexed[7] = 70;
+            REQUIRE(mem[7] == 70);
+
+            std::array<size_t, 5> too_small;
+            REQUIREABORTS((void)ints.build_index(too_small));
+        }
     }
 }
@@ -0,0 +1,193 @@
+#include "test_header.h"
+// test header must be first
+#include "ziglike/mdslice.h"
+#include <array>
+#include <vector>
+
+using namespace zl;
+
+static_assert(extents<3, dynamic_extent, 4>::rank == 3);
+static_assert(extents<3, dynamic_extent, 4>::rank_dynamic == 1);
+static_assert(std::is_same_v<dextents<2>,
+                             extents<dynamic_extent, dynamic_extent>>);
+static_assert(extents<2, 3>().size() == 6);
+static_assert(extents<2, dynamic_extent>(5).extent(1) == 5);
+
+TEST_SUITE("mdslice")
+{
+    TEST_CASE("extents")
+    {
+        SUBCASE("static and dynamic")
+        {
+            extents<2, dynamic_extent, 4> some(3);
+            REQUIRE(some.extent(0) == 2);
+            REQUIRE(some.extent(1) == 3);
+            REQUIRE(some.extent(2) == 4);
+            REQUIRE(some.size() == 24);
+
+            extents<2, dynamic_extent, 4> all(2, 3, 4);
+            REQUIRE(all == some);
+            REQUIREABORTS((extents<2, dynamic_extent, 4>(2, 3, 5)));
+        }
+    }
+
+    TEST_CASE("layouts")
+    {
+        SUBCASE("row major")
+        {
+            std::array<int, 12> mem;
+            for (size_t i = 0; i < mem.size(); ++i)
+                mem[i] = int(i);
+            mdslice<int, dextents<2>> matrix(slice<int>(mem), 3, 4);
+            REQUIRE(matrix.size() == 12);
+            REQUIRE(matrix.extent(0) == 3);
+            REQUIRE(matrix.extent(1) == 4);
+            REQUIRE(matrix(0, 0) == 0);
+            REQUIRE(matrix(1, 2) == 6);
+            REQUIRE(matrix(2, 3) == 11);
+            matrix(1, 1) = -1;
+            REQUIRE(mem[5] == -1);
+            REQUIRE(&matrix.at(2, 0).value() == &mem[8]);
+            REQUIRE(!matrix.at(3, 0).has_value());
+            REQUIRE(!matrix.at(0, 4).has_value());
+            REQUIRE(&matrix.unchecked_at(2, 1) == &mem[9]);
+#ifdef ZIGLIKE_BOUNDS_CHECKED
+            REQUIREABORTS((void)matrix(0, 4));
+#endif
+            REQUIREABORTS((mdslice<int, dextents<2>>(slice<int>(mem), 4, 4)));
+        }
+
+        SUBCASE("column major")
+        {
+            std::array<int, 12> mem;
+            for (size_t i = 0; i < mem.size(); ++i)
+                mem[i] = int(i);
+            mdslice<int, extents<3, 4>, layout_left> matrix(
+                (slice<int>(mem)));
+            REQUIRE(matrix(1, 0) == 1);
+            REQUIRE(matrix(0, 1) == 3);
+            REQUIRE(matrix(2, 3) == 11);
+            REQUIRE(matrix.mapping().stride(1) == 3);
+        }
+
+        SUBCASE("three dimensions")
+        {
+            std::vector<float> mem(2 * 3 * 4);
+            for (size_t i = 0; i < mem.size(); ++i)
+                mem[i] = float(i);
+            mdslice<float, extents<2, dynamic_extent, 4>> tensor(
+                slice<float>(mem), 3);
+            REQUIRE(tensor(1, 2, 3) == 23);
+            REQUIRE(tensor(1, 0, 2) == 14);
+
+            mdslice<float, extents<2, 3, 4>, layout_left> left(
+                (slice<float>(mem)));
+            REQUIRE(left(1, 2, 3) == 1 + (2 * 2) + (3 * 6));
+        }
+
+        SUBCASE("tiled")
+        {
+            std::array<int, 16> mem;
+            for (size_t i = 0; i < mem.size(); ++i)
+                mem[i] = int(i);
+            mdslice<int, dextents<2>, layout_tiled<2, 2>> image(
+                slice<int>(mem), 4, 4);
+            // first tile holds (0,0) (0,1) (1,0) (1,1)
+            REQUIRE(image(0, 0) == 0);
+            REQUIRE(image(0, 1) == 1);
+            REQUIRE(image(1, 0) == 2);
+            REQUIRE(image(1, 1) == 3);
+            REQUIRE(image(0, 2) == 4);
+            REQUIRE(image(2, 0) == 8);
+            REQUIRE(image(3, 3) == 15);
+
+            auto tile = image.tile(1, 0);
+            REQUIRE(tile.data() == &mem[8]);
+            REQUIRE(tile(1, 1) == image(3, 1));
+            REQUIREABORTS((void)image.tile(2, 0));
+            REQUIREABORTS((mdslice<int, dextents<2>, layout_tiled<2, 2>>(
+                slice<int>(mem), 3, 4)));
+        }
+    }
+
+    TEST_CASE("views")
+    {
+        SUBCASE("subview")
+        {
+            std::array<int, 20> mem;
+            for (size_t i = 0; i < mem.size(); ++i)
+                mem[i] = int(i);
+            mdslice<int, extents<4, 5>> matrix((slice<int>(mem)));
+
+            auto sub = matrix.subview({1, 2}, {2, 3});
+            REQUIRE(sub.extent(0) == 2);
+            REQUIRE(sub.extent(1) == 3);
+            REQUIRE(sub(0, 0) == matrix(1, 2));
+            REQUIRE(sub(1, 2) == matrix(2, 4));
+            REQUIRE(sub.mapping().required_span_size() == 8);
+
+            auto subsub = sub.subview({1, 1}, {1, 2});
+            REQUIRE(subsub(0, 1) == matrix(2, 4));
+
+            REQUIRE(matrix.subview({4, 0}, {0, 5}).size() == 0);
+            REQUIREABORTS((void)matrix.subview({3, 0}, {2, 1}));
+            REQUIREABORTS((void)matrix.subview({0, 6}, {0, 0}));
+
+            mdslice<int, extents<4, 5>, layout_left> left((slice<int>(mem)));
+            auto left_sub = left.subview({1, 1}, {2, 2});
+            REQUIRE(left_sub(1, 1) == left(2, 2));
+        }
+
+        SUBCASE("rows")
+        {
+            std::array<int, 12> mem;
+            for (size_t i = 0; i < mem.size(); ++i)
+                mem[i] = int(i);
+            mdslice<int, dextents<2>> matrix(slice<int>(mem), 3, 4);
+
+            size_t row_index = 0;
+            for (slice<int> row : matrix.rows()) {
+                REQUIRE(row.size() == 4);
+                REQUIRE(row.data() == &mem[row_index * 4]);
+                ++row_index;
+            }
+            REQUIRE(row_index == 3);
+            REQUIRE(matrix.rows().size() == 3);
+
+            // rows of a subview are still contiguous
+            auto sub = matrix.subview({1, 1}, {2, 2});
+            REQUIRE(sub.rows().size() == 2);
+            REQUIRE(sub.rows()[1].data() == &mem[9]);
+            REQUIRE(sub.rows()[1].size() == 2);
+
+            // but not in column major layout
+            mdslice<int, extents<3, 4>, layout_left> left((slice<int>(mem)));
+            REQUIREABORTS((void)left.rows());
+
+            std::vector<float> volume(2 * 3 * 4);
+            mdslice<float, extents<2, 3, 4>> cube((slice<float>(volume)));
+            REQUIRE(cube.rows().size() == 6);
+            REQUIRE(cube.subview({1, 0, 0}, {1, 3, 4}).rows()[2].data() ==
+                    &volume[20]);
+        }
+
+        SUBCASE("const")
+        {
+            std::array<int, 4> mem = {1, 2, 3, 4};
+            mdslice<int, extents<2, 2>> matrix((slice<int>(mem)));
+            mdslice<const int, extents<2, 2>> const_matrix = matrix;
+            REQUIRE(const_matrix(1, 0) == 3);
+            static_assert(
+                std::is_same_v<decltype(const_matrix(0, 0)), const int&>);
+        }
+
+        SUBCASE("constexpr")
+        {
+            static constexpr int mem[6] = {0, 1, 2, 3, 4, 5};
+            constexpr mdslice<const int, extents<2, 3>> matrix(
+                raw_slice(mem[0], 6));
+            static_assert(matrix(1, 2) == 5);
+            static_assert(matrix.subview({0, 1}, {2, 2})(1, 0) == 4);
+        }
+    }
+}
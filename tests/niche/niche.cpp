@@ -0,0 +1,216 @@
+#include "test_header.h"
+// test header must be first
+#include "ziglike/niche.h"
+#include "ziglike/opt.h"
+#include "ziglike/res.h"
+#include "ziglike/slice.h"
+#include "ziglike/try.h"
+#include <cstdint>
+#include <limits>
+
+using namespace zl;
+
+/// A handle which is an index into a table, reserving the top 256 values
+enum class handle : uint32_t
+{
+};
+
+template <> struct zl::niche<handle> : zl::niche_max_values<handle, 256>
+{};
+
+/// A measurement which is never NaN
+struct meters
+{
+    float value;
+    inline constexpr bool operator==(const meters& other) const noexcept
+    {
+        return value == other.value;
+    }
+    inline constexpr bool operator!=(const meters& other) const noexcept
+    {
+        return value != other.value;
+    }
+};
+
+template <> struct zl::niche<meters>
+{
+    static constexpr size_t count = 1;
+
+    static inline constexpr meters make(size_t) noexcept
+    {
+        return meters{std::numeric_limits<float>::quiet_NaN()};
+    }
+
+    static inline constexpr size_t index_of(const meters& item) noexcept
+    {
+        // NaN is the only value which is not equal to itself
+        return item.value != item.value ? 0 : 1;
+    }
+};
+
+enum class handle_error : uint8_t
+{
+    Okay,
+    ResultReleased,
+    NotFound,
+    Full,
+    Last = 255,
+};
+
+/// Status codes with a signed underlying type, which must not be sign
+/// extended into niche numbers past 255
+enum class signed_error : int8_t
+{
+    Okay,
+    ResultReleased,
+    Bad = -1,
+    Worse = -128,
+};
+
+static_assert(sizeof(opt<handle>) == sizeof(handle));
+static_assert(sizeof(opt<meters>) == sizeof(meters));
+static_assert(sizeof(res<handle, handle_error>) == sizeof(handle));
+// one niche is not enough for every status code
+static_assert(sizeof(res<meters, handle_error>) > sizeof(meters));
+static_assert(sizeof(opt<uint32_t>) > sizeof(uint32_t));
+static_assert(std::is_trivially_copyable_v<opt<handle>>);
+static_assert(std::is_trivially_copyable_v<res<handle, handle_error>>);
+
+static_assert(niche_max_values<uint8_t, 1>::make(0) == 255);
+static_assert(niche_max_values<uint8_t, 1>::index_of(255) == 0);
+static_assert(niche_max_values<uint8_t, 1>::index_of(254) == 1);
+static_assert(niche_max_values<uint8_t, 256>::index_of(0) == 255);
+static_assert(niche_max_values<uint16_t, 4>::make(3) == 65532);
+static_assert(niche_max_values<uint16_t, 4>::index_of(65531) == 4);
+
+constexpr opt<handle> constexpr_handles[] = {handle(0), {}, handle(7)};
+static_assert(constexpr_handles[0].has_value());
+static_assert(!constexpr_handles[1].has_value());
+static_assert(constexpr_handles[2] == handle(7));
+
+constexpr res<handle, handle_error> constexpr_results[] = {
+    handle(3), handle_error::Full, handle_error::Last};
+static_assert(constexpr_results[0].okay());
+static_assert(constexpr_results[1].err() == handle_error::Full);
+static_assert(constexpr_results[2].err() == handle_error::Last);
+
+TEST_SUITE("niche")
+{
+    TEST_CASE("opt")
+    {
+        SUBCASE("null state is stored in the niche")
+        {
+            opt<handle> maybe;
+            REQUIRE(!maybe.has_value());
+            REQUIRE(maybe != handle(0));
+            REQUIREABORTS((void)maybe.value());
+
+            maybe = handle(0);
+            REQUIRE(maybe.has_value());
+            REQUIRE(maybe.value() == handle(0));
+
+            // the largest handle which is not a niche is still a value
+            maybe.emplace(handle(UINT32_MAX - 256));
+            REQUIRE(maybe.has_value());
+            REQUIRE(maybe == handle(UINT32_MAX - 256));
+
+            maybe.reset();
+            REQUIRE(!maybe.has_value());
+            REQUIRE(maybe == opt<handle>{});
+        }
+
+        SUBCASE("custom niche")
+        {
+            opt<meters> distance;
+            REQUIRE(!distance.has_value());
+            distance = meters{1.5f};
+            REQUIRE(distance.has_value());
+            REQUIRE(distance.value().value == 1.5f);
+
+            opt<meters> copy = distance;
+            REQUIRE(copy == distance);
+            distance.reset();
+            REQUIRE(copy != distance);
+            REQUIRE(copy.has_value());
+        }
+
+        SUBCASE("table of optional handles is half the size")
+        {
+            opt<handle> table[64] = {};
+            static_assert(sizeof(table) == 64 * sizeof(uint32_t));
+            for (size_t i = 0; i < 64; i += 2)
+                table[i] = handle(i);
+            for (size_t i = 0; i < 64; ++i)
+                REQUIRE(table[i].has_value() == (i % 2 == 0));
+        }
+    }
+
+    TEST_CASE("res")
+    {
+        using result = res<handle, handle_error>;
+
+        SUBCASE("status codes are stored in the niches")
+        {
+            result okay = handle(12);
+            REQUIRE(okay.okay());
+            REQUIRE(okay.err() == handle_error::Okay);
+
+            result full = handle_error::Full;
+            REQUIRE(!full.okay());
+            REQUIRE(full.err() == handle_error::Full);
+            REQUIREABORTS((void)full.release());
+
+            result last = handle_error::Last;
+            REQUIRE(last.err() == handle_error::Last);
+
+            const handle released = okay.release();
+            REQUIRE(released == handle(12));
+            REQUIRE(okay.err() == handle_error::ResultReleased);
+            REQUIREABORTS((void)okay.release());
+        }
+
+        SUBCASE("signed status codes")
+        {
+            using signed_result = res<handle, signed_error>;
+            static_assert(sizeof(signed_result) == sizeof(handle));
+            signed_result bad = signed_error::Bad;
+            REQUIRE(!bad.okay());
+            REQUIRE(bad.err() == signed_error::Bad);
+            signed_result worse = signed_error::Worse;
+            REQUIRE(!worse.okay());
+            REQUIRE(worse.err() == signed_error::Worse);
+            signed_result okay = handle(4);
+            REQUIRE(okay.err() == signed_error::Okay);
+            REQUIRE(okay.release() == handle(4));
+            REQUIRE(okay.err() == signed_error::ResultReleased);
+        }
+
+        SUBCASE("moving")
+        {
+            result original = handle(5);
+            result moved = std::move(original);
+            REQUIRE(moved.okay());
+            REQUIRE(original.err() == handle_error::ResultReleased);
+            REQUIRE(moved.release() == handle(5));
+
+            result failed = handle_error::NotFound;
+            result moved_failure = std::move(failed);
+            REQUIRE(moved_failure.err() == handle_error::NotFound);
+        }
+
+        SUBCASE("try macro")
+        {
+            auto find = [](bool found) -> result {
+                if (found)
+                    return handle(1);
+                return handle_error::NotFound;
+            };
+            auto next = [&find](bool found) -> result {
+                TRY(found_handle, find(found));
+                return handle(uint32_t(found_handle) + 1);
+            };
+            REQUIRE(next(true).release() == handle(2));
+            REQUIRE(next(false).err() == handle_error::NotFound);
+        }
+    }
+}
@@ -4,6 +4,7 @@
 #include "ziglike/enumerate.h"
 #include "ziglike/opt.h"
 #include "ziglike/slice.h"
+#include <string>
 
 using namespace zl;
 
@@ -15,6 +16,107 @@ static_assert(sizeof(opt<slice<int>>) == sizeof(slice<int>),
 static_assert(sizeof(opt<int&>) == sizeof(int*),
               "Optional reference types are a different size than pointers");
 
+// opt is exactly as trivial as the type it contains
+static_assert(std::is_trivially_copyable_v<opt<int>>);
+static_assert(std::is_trivially_copyable_v<opt<double>>);
+static_assert(std::is_trivially_copyable_v<opt<trivial_t>>);
+static_assert(std::is_trivially_copyable_v<opt<int&>>);
+static_assert(std::is_trivially_copyable_v<opt<const int&>>);
+static_assert(std::is_trivially_copyable_v<opt<slice<int>>>);
+static_assert(std::is_trivially_destructible_v<opt<int>>);
+static_assert(std::is_trivially_destructible_v<opt<trivial_t>>);
+static_assert(std::is_trivially_destructible_v<opt<int&>>);
+static_assert(std::is_trivially_destructible_v<opt<slice<int>>>);
+static_assert(std::is_trivially_copy_constructible_v<opt<int>>);
+static_assert(std::is_trivially_move_constructible_v<opt<int>>);
+static_assert(std::is_trivially_copy_assignable_v<opt<int>>);
+static_assert(std::is_trivially_move_assignable_v<opt<int>>);
+
+static_assert(!std::is_trivially_copyable_v<opt<std::string>>);
+static_assert(!std::is_trivially_destructible_v<opt<std::string>>);
+static_assert(std::is_copy_constructible_v<opt<std::string>>);
+static_assert(std::is_move_constructible_v<opt<std::string>>);
+static_assert(std::is_copy_assignable_v<opt<std::string>>);
+static_assert(std::is_move_assignable_v<opt<std::string>>);
+
+static_assert(!std::is_trivially_destructible_v<opt<moveable_t>>);
+static_assert(!std::is_copy_constructible_v<opt<moveable_t>>);
+static_assert(!std::is_copy_assignable_v<opt<moveable_t>>);
+static_assert(std::is_move_constructible_v<opt<moveable_t>>);
+static_assert(std::is_move_assignable_v<opt<moveable_t>>);
+
+// nonmoveable_t can still be copied, and moving an opt of it falls back to
+// copying, like moving the type itself does
+static_assert(std::is_copy_constructible_v<opt<nonmoveable_t>>);
+static_assert(!std::is_trivially_copyable_v<opt<nonmoveable_t>>);
+
+// opt of a literal type can be used in constant expressions
+constexpr opt<int> constexpr_table[] = {1, {}, 3};
+static_assert(constexpr_table[0].has_value());
+static_assert(constexpr_table[0].value() == 1);
+static_assert(!constexpr_table[1].has_value());
+static_assert(constexpr_table[2] == 3);
+
+constexpr int constexpr_array[] = {4, 5, 6};
+constexpr opt<slice<const int>> constexpr_slice =
+    raw_slice(constexpr_array[0], 3);
+constexpr opt<slice<const int>> constexpr_null_slice;
+static_assert(constexpr_slice.has_value());
+static_assert(constexpr_slice.value().size() == 3);
+static_assert(!constexpr_null_slice.has_value());
+
+constexpr opt<const int&> constexpr_ref = constexpr_array[1];
+static_assert(constexpr_ref.value() == 5);
+
+inline constexpr int constexpr_opt_operations()
+{
+    opt<int> maybe;
+    maybe = 10;
+    maybe.reset();
+    maybe.emplace(20);
+    opt<int> copy = maybe;
+    maybe = copy.value() + 1;
+    return maybe.value();
+}
+static_assert(constexpr_opt_operations() == 21);
+
+constexpr opt<int> constexpr_null;
+static_assert(constexpr_table[0].value_or(5) == 1);
+static_assert(constexpr_null.value_or(5) == 5);
+static_assert(constexpr_table[2].transform([](int i) { return i * 2; }) == 6);
+static_assert(!constexpr_null.transform([](int i) { return i * 2; }));
+static_assert(constexpr_table[0]
+                  .and_then([](int) -> opt<int> { return {}; })
+                  .or_else([] { return opt<int>(9); }) == 9);
+
+#ifdef __cpp_lib_constexpr_dynamic_alloc
+// from C++20, non-trivial payloads also work in constant expressions
+struct constexpr_non_trivial_t
+{
+    int value;
+    inline constexpr constexpr_non_trivial_t(int value) noexcept : value(value)
+    {
+    }
+    inline constexpr constexpr_non_trivial_t(
+        const constexpr_non_trivial_t& other) noexcept
+        : value(other.value)
+    {
+    }
+    inline constexpr ~constexpr_non_trivial_t() {}
+};
+
+inline constexpr bool constexpr_non_trivial_opt()
+{
+    opt<constexpr_non_trivial_t> maybe = constexpr_non_trivial_t(1);
+    maybe.reset();
+    maybe.emplace(2);
+    opt<constexpr_non_trivial_t> copy = maybe;
+    maybe = copy;
+    return copy.value().value == 2 && maybe.value().value == 2;
+}
+static_assert(constexpr_non_trivial_opt());
+#endif
+
 TEST_SUITE("opt")
 {
     TEST_CASE("Construction and type behavior")
@@ -242,6 +344,36 @@ TEST_SUITE("opt")
             REQUIRE(maybe_copyguy_moved.has_value());
         }
 
+        SUBCASE("copying and moving non-trivial types")
+        {
+            opt<std::string> name = std::string("a string too long for sso");
+            opt<std::string> copy = name;
+            REQUIRE(copy.has_value());
+            REQUIRE(copy.value() == name.value());
+            REQUIRE(copy.value().data() != name.value().data());
+
+            opt<std::string> moved = std::move(copy);
+            REQUIRE(moved.value() == "a string too long for sso");
+
+            opt<std::string> empty;
+            opt<std::string> empty_copy = empty;
+            REQUIRE(!empty_copy.has_value());
+
+            moved = empty;
+            REQUIRE(!moved.has_value());
+            moved = name;
+            REQUIRE(moved.value() == name.value());
+            empty = std::move(moved);
+            REQUIRE(empty.has_value());
+
+            moveable_t moveguy;
+            std::snprintf(moveguy.nothing, 50, "moved");
+            opt<moveable_t> maybe_moveguy = std::move(moveguy);
+            opt<moveable_t> other_moveguy = std::move(maybe_moveguy);
+            REQUIRE(other_moveguy.has_value());
+            REQUIRE(strcmp(other_moveguy.value().nothing, "moved") == 0);
+        }
+
         SUBCASE("copying slice")
         {
             std::array<uint8_t, 128> bytes;
@@ -275,4 +407,191 @@ TEST_SUITE("opt")
         }
 #endif
     }
+
+    TEST_CASE("Combinators")
+    {
+        static size_t copies = 0;
+        static size_t moves = 0;
+        struct counted
+        {
+            int value;
+            inline explicit counted(int value) noexcept : value(value) {}
+            inline counted(const counted& other) noexcept : value(other.value)
+            {
+                ++copies;
+            }
+            inline counted(counted&& other) noexcept : value(other.value)
+            {
+                ++moves;
+            }
+            counted& operator=(const counted&) = delete;
+            counted& operator=(counted&&) = delete;
+        };
+
+        SUBCASE("value_or")
+        {
+            opt<int> maybe;
+            REQUIRE(maybe.value_or(3) == 3);
+            maybe = 4;
+            REQUIRE(maybe.value_or(3) == 4);
+
+            int fallback = 10;
+            int target = 20;
+            opt<int&> ref;
+            int& result = ref.value_or(fallback);
+            REQUIRE(&result == &fallback);
+            ref = target;
+            REQUIRE(&ref.value_or(fallback) == &target);
+
+            std::array<uint8_t, 8> bytes = {};
+            std::array<uint8_t, 2> other_bytes = {};
+            opt<slice<uint8_t>> maybe_bytes;
+            REQUIRE(maybe_bytes.value_or(slice<uint8_t>(other_bytes)).size() ==
+                    2);
+            maybe_bytes = slice<uint8_t>(bytes);
+            REQUIRE(maybe_bytes.value_or(slice<uint8_t>(other_bytes)).size() ==
+                    8);
+        }
+
+        SUBCASE("value_or moves out of rvalues")
+        {
+            copies = 0;
+            moves = 0;
+            opt<counted> maybe(std::in_place, 1);
+            counted out = std::move(maybe).value_or(counted(2));
+            REQUIRE(out.value == 1);
+            REQUIRE(copies == 0);
+            REQUIRE(moves == 1);
+
+            counted copied = maybe.value_or(counted(2));
+            REQUIRE(copies == 1);
+        }
+
+        SUBCASE("transform")
+        {
+            opt<int> maybe;
+            auto twice = [](int i) { return i * 2; };
+            REQUIRE(!maybe.transform(twice).has_value());
+            maybe = 21;
+            opt<int> result = maybe.transform(twice);
+            REQUIRE(result == 42);
+
+            // returning a reference produces an optional reference
+            trivial_t item{1, nullptr};
+            opt<trivial_t&> ref = item;
+            opt<int&> member =
+                ref.transform([](trivial_t& t) -> int& { return t.whatever; });
+            REQUIRE(member.has_value());
+            member.value() = 5;
+            REQUIRE(item.whatever == 5);
+
+            std::array<int, 6> ints = {1, 2, 3, 4, 5, 6};
+            opt<slice<int>> maybe_ints = slice<int>(ints);
+            opt<size_t> size =
+                maybe_ints.transform([](slice<int> s) { return s.size(); });
+            REQUIRE(size == 6);
+            opt<slice<int>> front = maybe_ints.transform(
+                [](slice<int> s) { return s.first(2); });
+            REQUIRE(front.value().size() == 2);
+        }
+
+        SUBCASE("transform does not copy")
+        {
+            copies = 0;
+            moves = 0;
+            opt<counted> maybe(std::in_place, 3);
+            opt<int> value =
+                maybe.transform([](const counted& c) { return c.value; });
+            REQUIRE(value == 3);
+            opt<counted> moved = std::move(maybe).transform(
+                [](counted&& c) { return counted(std::move(c)); });
+            REQUIRE(moved.value().value == 3);
+            REQUIRE(copies == 0);
+        }
+
+        SUBCASE("rvalue combinators forward large move-only payloads")
+        {
+            struct large
+            {
+                std::array<uint64_t, 64> words;
+                inline explicit large(uint64_t first) noexcept : words{first}
+                {
+                }
+                large(const large&) = delete;
+                inline large(large&& other) noexcept : words(other.words)
+                {
+                    ++moves;
+                }
+            };
+            static_assert(!std::is_copy_constructible_v<large>);
+
+            // the payload reaches the callable by reference, with no copy or
+            // move in between
+            moves = 0;
+            opt<large> maybe(std::in_place, 7);
+            const large* const address = &maybe.value();
+            opt<uint64_t> first =
+                std::move(maybe).transform([address](large&& item) {
+                    REQUIRE(&item == address);
+                    return item.words[0];
+                });
+            REQUIRE(first == 7);
+            opt<uint64_t> chained =
+                std::move(maybe).and_then([address](large&& item) {
+                    REQUIRE(&item == address);
+                    return opt<uint64_t>(item.words[0] + 1);
+                });
+            REQUIRE(chained == 8);
+            REQUIRE(moves == 0);
+
+            // a payload returned by value is moved into the result, once in
+            // the callable and once into the returned opt, and never copied
+            opt<large> moved = std::move(maybe).transform(
+                [](large&& item) { return large(std::move(item)); });
+            REQUIRE(moved.value().words[0] == 7);
+            REQUIRE(moves == 2);
+        }
+
+        SUBCASE("and_then")
+        {
+            auto half = [](int i) -> opt<int> {
+                if (i % 2 != 0)
+                    return {};
+                return i / 2;
+            };
+            opt<int> maybe = 12;
+            REQUIRE(maybe.and_then(half).and_then(half) == 3);
+            REQUIRE(!maybe.and_then(half).and_then(half).and_then(half));
+            opt<int> null;
+            REQUIRE(!null.and_then(half).has_value());
+
+            int target = 0;
+            opt<int&> ref = target;
+            opt<int&> same =
+                ref.and_then([](int& i) -> opt<int&> { return i; });
+            REQUIRE(same.strict_compare(target));
+        }
+
+        SUBCASE("or_else")
+        {
+            opt<int> maybe;
+            REQUIRE(maybe.or_else([] { return opt<int>(1); }) == 1);
+            maybe = 2;
+            REQUIRE(maybe.or_else([] { return opt<int>(1); }) == 2);
+
+            copies = 0;
+            moves = 0;
+            opt<counted> full(std::in_place, 4);
+            opt<counted> result = std::move(full).or_else(
+                [] { return opt<counted>(std::in_place, 5); });
+            REQUIRE(result.value().value == 4);
+            REQUIRE(copies == 0);
+
+            int fallback = 0;
+            opt<int&> ref;
+            opt<int&> filled =
+                ref.or_else([&fallback] { return opt<int&>(fallback); });
+            REQUIRE(filled.strict_compare(fallback));
+        }
+    }
 }
@@ -0,0 +1,153 @@
+#include "test_header.h"
+// test header must be first
+#include "ziglike/opt_array.h"
+#include <array>
+#include <vector>
+
+using namespace zl;
+
+// one bit per item instead of a flag and padding
+static_assert(sizeof(opt_array<uint32_t, 64>) ==
+              64 * sizeof(uint32_t) + sizeof(uint64_t));
+static_assert(sizeof(opt_array<uint32_t, 64>) * 2 <
+              sizeof(std::array<opt<uint32_t>, 64>) + 64 * sizeof(uint32_t));
+static_assert(opt_array<uint8_t, 65>::words == 2);
+static_assert(std::is_trivially_copyable_v<opt_array<int, 10>>);
+
+constexpr opt_array<int, 4> make_constexpr_array()
+{
+    opt_array<int, 4> out;
+    out.emplace(1, 10);
+    out.emplace(3, 30);
+    out.reset(3);
+    return out;
+}
+constexpr opt_array<int, 4> constexpr_array = make_constexpr_array();
+static_assert(!constexpr_array.has_value(0));
+static_assert(constexpr_array[1].value() == 10);
+static_assert(!constexpr_array[3].has_value());
+
+TEST_SUITE("opt_array")
+{
+    TEST_CASE("element access")
+    {
+        SUBCASE("starts empty")
+        {
+            opt_array<int, 100> array;
+            REQUIRE(array.size() == 100);
+            REQUIRE(array.count() == 0);
+            for (size_t i = 0; i < array.size(); ++i) {
+                REQUIRE(!array.has_value(i));
+                REQUIRE(!array[i].has_value());
+            }
+        }
+
+        SUBCASE("emplace and reset")
+        {
+            opt_array<int, 100> array;
+            int& item = array.emplace(70, 7);
+            REQUIRE(item == 7);
+            REQUIRE(array.has_value(70));
+            REQUIRE(array.count() == 1);
+
+            opt<int&> maybe = array[70];
+            REQUIRE(maybe.has_value());
+            maybe.value() = 8;
+            REQUIRE(array[70].value() == 8);
+
+            array.emplace(70, 9);
+            REQUIRE(array.count() == 1);
+            REQUIRE(array[70].value() == 9);
+
+            array.reset(70);
+            REQUIRE(!array[70].has_value());
+            REQUIRE(array.count() == 0);
+        }
+
+        SUBCASE("const access")
+        {
+            opt_array<int, 8> array;
+            array.emplace(2, 20);
+            const opt_array<int, 8>& constant = array;
+            opt<const int&> item = constant[2];
+            REQUIRE(item.value() == 20);
+            REQUIRE(!constant[3].has_value());
+        }
+
+        SUBCASE("reset all")
+        {
+            opt_array<int, 130> array;
+            for (size_t i = 0; i < array.size(); i += 3)
+                array.emplace(i, int(i));
+            REQUIRE(array.count() == 44);
+            array.reset();
+            REQUIRE(array.count() == 0);
+        }
+
+#ifdef ZIGLIKE_BOUNDS_CHECKED
+        SUBCASE("bounds checked")
+        {
+            opt_array<int, 10> array;
+            REQUIREABORTS((void)array[10]);
+            REQUIREABORTS(array.emplace(10, 1));
+            REQUIREABORTS(array.reset(10));
+        }
+#endif
+    }
+
+    TEST_CASE("bulk access")
+    {
+        SUBCASE("for_each visits present items in order")
+        {
+            opt_array<int, 200> array;
+            const size_t indices[] = {0, 1, 63, 64, 127, 128, 199};
+            for (size_t index : indices)
+                array.emplace(index, int(index) * 2);
+
+            std::vector<size_t> visited;
+            array.for_each([&visited](size_t index, int& item) {
+                REQUIRE(item == int(index) * 2);
+                visited.push_back(index);
+                item = 0;
+            });
+            const std::vector<size_t> expected(std::begin(indices),
+                                               std::end(indices));
+            REQUIRE(visited == expected);
+
+            const opt_array<int, 200>& constant = array;
+            size_t count = 0;
+            constant.for_each([&count](size_t, const int& item) {
+                REQUIRE(item == 0);
+                ++count;
+            });
+            REQUIRE(count == 7);
+        }
+
+        SUBCASE("raw items and presence bitmap")
+        {
+            opt_array<uint32_t, 70> array;
+            array.emplace(3, 33);
+            array.emplace(69, 99);
+
+            slice<uint32_t> items = array.items();
+            REQUIRE(items.size() == 70);
+            REQUIRE(items[3] == 33);
+            REQUIRE(items[69] == 99);
+            items[69] = 100;
+            REQUIRE(array[69].value() == 100);
+
+            slice<const uint64_t> presence = array.presence();
+            REQUIRE(presence.size() == 2);
+            REQUIRE(presence[0] == (uint64_t(1) << 3));
+            REQUIRE(presence[1] == (uint64_t(1) << 5));
+
+            // mask out a comparison over every slot with the bitmap
+            size_t matches = 0;
+            for (size_t i = 0; i < items.size(); ++i) {
+                const bool present = (presence[i / 64] >> (i % 64)) & 1;
+                matches += present && items[i] > 30;
+            }
+            REQUIRE(matches == 2);
+        }
+    }
+}
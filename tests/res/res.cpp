@@ -11,6 +11,26 @@
 
 using namespace zl;
 
+// res of a literal type can be used in constant expressions
+constexpr res<int, StatusCodeA> constexpr_table[] = {1, StatusCodeA::Whatever};
+static_assert(constexpr_table[0].okay());
+static_assert(!constexpr_table[1].okay());
+static_assert(constexpr_table[1].err() == StatusCodeA::Whatever);
+
+inline constexpr int constexpr_release(bool succeed)
+{
+    res<int, StatusCodeA> result =
+        succeed ? res<int, StatusCodeA>(42)
+                : res<int, StatusCodeA>(StatusCodeA::BadAccess);
+    if (!result.okay())
+        return -1;
+    const int out = result.release();
+    return result.err() == StatusCodeA::ResultReleased ? out : 0;
+}
+static_assert(constexpr_release(true) == 42);
+static_assert(constexpr_release(false) == -1);
+static_assert(std::is_trivially_destructible_v<res<int, StatusCodeA>>);
+
 TEST_SUITE("res")
 {
     TEST_CASE("Construction and type behavior")
@@ -3,6 +3,7 @@
 #include "ziglike/detail/is_container.h"
 #include "ziglike/enumerate.h"
 #include "ziglike/slice.h"
+#include <algorithm>
 #include <array>
 #include <vector>
 
@@ -21,6 +22,21 @@ using namespace zl;
 static_assert(std::is_same_v<slice<const uint8_t>::type, const uint8_t>,
               "slice::type doesnt work as expected");
 
+static_assert(
+    std::is_same_v<
+        std::iterator_traits<slice<int>::iterator>::iterator_category,
+        std::random_access_iterator_tag>,
+    "slice iterators should be random access");
+static_assert(std::is_same_v<slice<const int>::iterator::value_type, int>,
+              "iterator value_type should not be const");
+static_assert(std::is_convertible_v<slice<int>::iterator,
+                                    slice<int>::const_iterator>,
+              "iterator should convert to const_iterator");
+#if defined(__cpp_lib_concepts)
+static_assert(std::contiguous_iterator<slice<int>::iterator>);
+static_assert(std::contiguous_iterator<slice<int>::const_iterator>);
+#endif
+
 TEST_SUITE("slice")
 {
     TEST_CASE("Construction and type behavior")
@@ -150,6 +166,174 @@ TEST_SUITE("slice")
             }
         }
 
+        SUBCASE("random access iteration")
+        {
+            std::array<int, 64> mem;
+            for (size_t i = 0; i < mem.size(); ++i)
+                mem[i] = int((i * 37) % mem.size());
+            slice<int> ints(mem);
+
+            REQUIRE(size_t(ints.end() - ints.begin()) == ints.size());
+            REQUIRE(ints.begin() + 64 == ints.end());
+            REQUIRE(64 + ints.begin() == ints.end());
+            REQUIRE(ints.end() - 64 == ints.begin());
+            REQUIRE(ints.begin() < ints.end());
+            REQUIRE(ints.begin() <= ints.begin());
+            REQUIRE(ints.begin()[3] == mem[3]);
+            auto iter = ints.end();
+            --iter;
+            REQUIRE(*iter == mem[63]);
+            iter -= 10;
+            REQUIRE(&*iter == &mem[53]);
+
+            std::sort(ints.begin(), ints.end());
+            for (size_t i = 0; i < mem.size(); ++i)
+                REQUIRE(mem[i] == int(i));
+
+            const slice<const int> const_ints(ints);
+            auto found =
+                std::lower_bound(const_ints.begin(), const_ints.end(), 20);
+            REQUIRE(found - const_ints.begin() == 20);
+            REQUIRE(found.ptr() == &mem[20]);
+
+            std::reverse(ints.begin(), ints.end());
+            std::nth_element(ints.begin(), ints.begin() + 10, ints.end());
+            REQUIRE(ints.begin()[10] == 10);
+
+            slice<int>::const_iterator converted = ints.begin();
+            REQUIRE(converted.ptr() == ints.data());
+        }
+
+        SUBCASE("indexing")
+        {
+            std::array<int, 8> mem = {0, 1, 2, 3, 4, 5, 6, 7};
+            slice<int> ints(mem);
+            const slice<const int> const_ints(ints);
+
+            REQUIRE(ints[3] == 3);
+            ints[3] = 30;
+            REQUIRE(mem[3] == 30);
+            REQUIRE(&const_ints[7] == &mem[7]);
+            REQUIRE(&ints.unchecked_at(5) == &mem[5]);
+            static_assert(std::is_same_v<decltype(const_ints[0]), const int&>);
+
+#ifdef ZIGLIKE_BOUNDS_CHECKED
+            REQUIREABORTS((void)ints[8]);
+            REQUIREABORTS((void)const_ints[size_t(-1)]);
+#endif
+
+            opt<int&> item = ints.at(2);
+            REQUIRE(item.has_value());
+            REQUIRE(&item.value() == &mem[2]);
+            item.value() = 20;
+            REQUIRE(mem[2] == 20);
+            REQUIRE(!ints.at(8).has_value());
+            REQUIRE(!ints.at(100).has_value());
+            static_assert(
+                std::is_same_v<decltype(const_ints.at(0)), opt<const int&>>);
+        }
+
+        SUBCASE("subslicing")
+        {
+            std::array<int, 10> mem = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+            slice<int> ints(mem);
+
+            slice<int> middle = ints.subslice(2, 5);
+            REQUIRE(middle.data() == &mem[2]);
+            REQUIRE(middle.size() == 3);
+            REQUIRE(ints.subslice(10, 10).size() == 0);
+            REQUIRE(ints.subslice(0, 10) == ints);
+            REQUIREABORTS((void)ints.subslice(5, 4));
+            REQUIREABORTS((void)ints.subslice(0, 11));
+
+            REQUIRE(ints.first(3) == ints.subslice(0, 3));
+            REQUIRE(ints.first(0).size() == 0);
+            REQUIREABORTS((void)ints.first(11));
+
+            REQUIRE(ints.last(3) == ints.subslice(7, 10));
+            REQUIRE(ints.last(10) == ints);
+            REQUIREABORTS((void)ints.last(11));
+
+            REQUIRE(ints.drop_front(4) == ints.subslice(4, 10));
+            REQUIRE(ints.drop_front(10).size() == 0);
+            REQUIREABORTS((void)ints.drop_front(11));
+
+            auto [front, back] = ints.split_at(6);
+            REQUIRE(front == ints.first(6));
+            REQUIRE(back == ints.last(4));
+            REQUIREABORTS((void)ints.split_at(11));
+
+            // narrowing works on const slices too, and chains
+            const slice<const int> const_ints(ints);
+            REQUIRE(const_ints.drop_front(1).first(2).data() == &mem[1]);
+        }
+
+        SUBCASE("constexpr subslicing")
+        {
+            static constexpr int mem[] = {1, 2, 3, 4};
+            constexpr slice<const int> ints = raw_slice(mem[0], 4);
+            static_assert(ints.last(2).first(1).size() == 1);
+            static_assert(ints.split_at(3).second.data() == &mem[3]);
+        }
+
+        SUBCASE("chunks")
+        {
+            std::array<int, 10> mem = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+            slice<int> ints(mem);
+
+            auto threes = ints.chunks(3);
+            REQUIRE(threes.size() == 3);
+            int expected = 0;
+            for (slice<int> chunk : threes) {
+                REQUIRE(chunk.size() == 3);
+                for (int item : chunk)
+                    REQUIRE(item == expected++);
+            }
+            REQUIRE(expected == 9);
+            REQUIRE(threes.remainder().size() == 1);
+            REQUIRE(threes.remainder().data() == &mem[9]);
+            REQUIRE(threes[1].data() == &mem[3]);
+
+            REQUIRE(ints.chunks(5).size() == 2);
+            REQUIRE(ints.chunks(5).remainder().size() == 0);
+            REQUIRE(ints.chunks(11).size() == 0);
+            REQUIRE(ints.chunks(11).remainder() == ints);
+            REQUIREABORTS((void)ints.chunks(0));
+
+            auto fours = ints.chunks<4>();
+            static_assert(decltype(fours)::chunk_size == 4);
+            REQUIRE(fours.size() == 2);
+            size_t count = 0;
+            for (fixed_slice<int, 4> chunk : fours) {
+                REQUIRE(chunk.data() == &mem[count * 4]);
+                ++count;
+            }
+            REQUIRE(count == 2);
+            REQUIRE(fours.remainder() == ints.last(2));
+        }
+
+        SUBCASE("windows")
+        {
+            std::array<int, 5> mem = {0, 1, 2, 3, 4};
+            slice<int> ints(mem);
+
+            auto pairs = ints.windows(2);
+            REQUIRE(pairs.size() == 4);
+            size_t count = 0;
+            for (slice<int> window : pairs) {
+                REQUIRE(window.size() == 2);
+                REQUIRE(window.data() == &mem[count]);
+                ++count;
+            }
+            REQUIRE(count == 4);
+
+            REQUIRE(ints.windows(5).size() == 1);
+            REQUIRE(ints.windows(5)[0] == ints);
+            REQUIRE(ints.windows(6).size() == 0);
+            REQUIRE(ints.windows(6).begin() == ints.windows(6).end());
+            REQUIREABORTS((void)ints.windows(0));
+        }
+
         SUBCASE("subslice construction")
         {
             std::array<uint8_t, 128> mem;
@@ -0,0 +1,169 @@
+#include "test_header.h"
+// test header must be first
+#include "ziglike/split.h"
+#include "ziglike/zigstdint.h"
+#include <array>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace zl;
+
+static slice<const char> str(const char* string)
+{
+    return raw_slice(*string, std::strlen(string));
+}
+
+static std::string_view view(slice<const char> slice)
+{
+    return {slice.data(), slice.size()};
+}
+
+/// Collect every item of a splitter using range-for.
+template <typename Splitter>
+static std::vector<std::string_view> collect(const Splitter& splitter)
+{
+    std::vector<std::string_view> out;
+    for (slice<const char> item : splitter) {
+        out.push_back(view(item));
+    }
+    return out;
+}
+
+using strings = std::vector<std::string_view>;
+
+TEST_SUITE("split")
+{
+    TEST_CASE("split")
+    {
+        SUBCASE("split_scalar")
+        {
+            REQUIRE(collect(split_scalar(str("a,b,c"), ',')) ==
+                    strings{"a", "b", "c"});
+            REQUIRE(collect(split_scalar(str("a,,b,"), ',')) ==
+                    strings{"a", "", "b", ""});
+            REQUIRE(collect(split_scalar(str(""), ',')) == strings{""});
+            REQUIRE(collect(split_scalar(str(","), ',')) == strings{"", ""});
+            REQUIRE(collect(split_scalar(str("abc"), ',')) == strings{"abc"});
+        }
+
+        SUBCASE("next, peek, rest, and reset")
+        {
+            auto fields = split_scalar(str("one two three"), ' ');
+            REQUIRE(view(fields.rest()) == "one two three");
+            REQUIRE(view(fields.peek().value()) == "one");
+            REQUIRE(view(fields.next().value()) == "one");
+            REQUIRE(view(fields.rest()) == "two three");
+            REQUIRE(view(fields.next().value()) == "two");
+            REQUIRE(view(fields.next().value()) == "three");
+            REQUIRE(view(fields.rest()).empty());
+            REQUIRE(!fields.next().has_value());
+            REQUIRE(!fields.peek().has_value());
+            fields.reset();
+            REQUIRE(view(fields.next().value()) == "one");
+        }
+
+        SUBCASE("items point into the buffer")
+        {
+            const char* text = "key=value";
+            auto parts = split_scalar(str(text), '=');
+            slice<const char> key = parts.next().value();
+            slice<const char> value = parts.next().value();
+            REQUIRE(key.data() == text);
+            REQUIRE(value.data() == text + 4);
+        }
+
+        SUBCASE("split_any")
+        {
+            const std::array<char, 2> separators = {',', ';'};
+            REQUIRE(collect(split_any(str("a,b;c;;d"), separators)) ==
+                    strings{"a", "b", "c", "", "d"});
+        }
+
+        SUBCASE("split_sequence")
+        {
+            REQUIRE(collect(split_sequence(str("a\r\nb\r\n\r\nc"),
+                                           str("\r\n"))) ==
+                    strings{"a", "b", "", "c"});
+            REQUIRE(collect(split_sequence(str("a::b:c"), str("::"))) ==
+                    strings{"a", "b:c"});
+            REQUIRE(collect(split_sequence(str("::"), str("::"))) ==
+                    strings{"", ""});
+            REQUIRE(collect(split_sequence(str("a"), str("long delimiter"))) ==
+                    strings{"a"});
+            REQUIREABORTS((void)split_sequence(str("a"), str("")));
+        }
+
+        SUBCASE("long lines")
+        {
+            // long enough that the vectorized search is used
+            std::string text;
+            std::vector<std::string> expected;
+            for (size_t i = 0; i < 100; ++i) {
+                expected.push_back(std::string(i, 'x'));
+                text += expected.back();
+                text += '\n';
+            }
+            size_t line = 0;
+            for (slice<const char> item :
+                 split_scalar(raw_slice(*text.data(), text.size()), '\n')) {
+                if (line < expected.size()) {
+                    REQUIRE(view(item) == expected[line]);
+                } else {
+                    REQUIRE(item.size() == 0);
+                }
+                ++line;
+            }
+            REQUIRE(line == expected.size() + 1);
+        }
+
+        SUBCASE("other types")
+        {
+            std::array<u32, 7> ints = {1, 2, 0, 3, 0, 0, 4};
+            std::vector<size_t> sizes;
+            for (slice<const u32> item : split_scalar(slice<u32>(ints), 0U)) {
+                sizes.push_back(item.size());
+            }
+            REQUIRE(sizes == std::vector<size_t>{2, 1, 0, 1});
+        }
+    }
+
+    TEST_CASE("tokenize")
+    {
+        SUBCASE("tokenize_scalar")
+        {
+            REQUIRE(collect(tokenize_scalar(str("  a  b c "), ' ')) ==
+                    strings{"a", "b", "c"});
+            REQUIRE(collect(tokenize_scalar(str(""), ' ')).empty());
+            REQUIRE(collect(tokenize_scalar(str("   "), ' ')).empty());
+            REQUIRE(collect(tokenize_scalar(str("abc"), ' ')) ==
+                    strings{"abc"});
+        }
+
+        SUBCASE("tokenize rest")
+        {
+            auto tokens = tokenize_scalar(str("  a  b  "), ' ');
+            REQUIRE(view(tokens.rest()) == "a  b  ");
+            REQUIRE(view(tokens.next().value()) == "a");
+            REQUIRE(view(tokens.rest()) == "b  ");
+            REQUIRE(view(tokens.next().value()) == "b");
+            REQUIRE(view(tokens.rest()).empty());
+            REQUIRE(!tokens.next().has_value());
+        }
+
+        SUBCASE("tokenize_any")
+        {
+            const std::array<char, 3> whitespace = {' ', '\t', '\n'};
+            REQUIRE(collect(tokenize_any(str("\tint  main\n(void)\n"),
+                                         whitespace)) ==
+                    strings{"int", "main", "(void)"});
+        }
+
+        SUBCASE("tokenize_sequence")
+        {
+            REQUIRE(collect(tokenize_sequence(str("<>a<><>b<"), str("<>"))) ==
+                    strings{"a", "b<"});
+        }
+    }
+}
@@ -2,10 +2,29 @@
 // test header must be first
 #include "ziglike/stdmem.h"
 #include "ziglike/zigstdint.h"
+#include <algorithm>
 #include <array>
+#include <string>
+#include <string_view>
+#include <vector>
 
 using namespace zl;
 
+/// Executor which runs everything inline and records the tasks it was given.
+struct recording_executor
+{
+    std::vector<size_t>* tasks;
+    size_t concurrency() const { return 4; }
+    template <typename Task>
+    void run(size_t task_count, const Task& task) const
+    {
+        for (size_t i = 0; i < task_count; ++i) {
+            tasks->push_back(i);
+            task(i);
+        }
+    }
+};
+
 TEST_SUITE("stdmem")
 {
     TEST_CASE("functions")
@@ -35,6 +54,94 @@ TEST_SUITE("stdmem")
             REQUIRE(memcompare(c, c));
         }
 
+        SUBCASE("memcopy_streaming")
+        {
+            std::array<u8, 1024> bytes;
+            for (size_t i = 0; i < bytes.size(); ++i) {
+                bytes[i] = u8(i * 13);
+            }
+            std::array<u8, 1024> copied;
+
+            slice<u8> a(bytes, 0, 100);
+            slice<u8> b(bytes, 20, 120);
+            REQUIRE(!memcopy_streaming(a, b, 0));
+            REQUIRE(!memcopy_streaming(slice<u8>(copied, 0, 99), a, 0));
+
+            // every misalignment of the destination, threshold of zero so it
+            // always streams
+            for (size_t offset = 0; offset < 40; ++offset) {
+                for (size_t length : {0, 1, 31, 32, 33, 200, 900}) {
+                    copied.fill(0);
+                    slice<u8> destination(copied, offset, offset + length);
+                    slice<u8> source(bytes, 3, 3 + length);
+                    REQUIRE(memcopy_streaming(destination, source, 0));
+                    REQUIRE(memcompare(destination, source));
+                    for (size_t i = 0; i < offset; ++i) {
+                        REQUIRE(copied[i] == 0);
+                    }
+                    for (size_t i = offset + length; i < copied.size(); ++i) {
+                        REQUIRE(copied[i] == 0);
+                    }
+                }
+            }
+
+            std::array<u64, 64> longs;
+            std::array<u64, 64> longs_copied{};
+            for (size_t i = 0; i < longs.size(); ++i) {
+                longs[i] = i * 0x0101010101010101;
+            }
+            REQUIRE(memcopy_streaming(slice<u64>(longs_copied),
+                                      slice<u64>(longs)));
+            REQUIRE(longs == longs_copied);
+        }
+
+        SUBCASE("memcopy_parallel and memfill_parallel")
+        {
+            const size_t count =
+                (ZIGLIKE_PARALLEL_MIN_CHUNK / sizeof(u32)) * 3 + 17;
+            std::vector<u32> source(count);
+            for (size_t i = 0; i < count; ++i) {
+                source[i] = u32(i);
+            }
+            std::vector<u32> destination(count, 0);
+
+            std::vector<size_t> tasks;
+            REQUIRE(memcopy_parallel(slice<u32>(destination),
+                                     slice<u32>(source),
+                                     recording_executor{&tasks}));
+            REQUIRE(tasks.size() == 4);
+            REQUIRE(destination == source);
+
+            // same validation as memcopy
+            REQUIRE(!memcopy_parallel(slice<u32>(destination, 0, 10),
+                                      slice<u32>(source)));
+            REQUIRE(!memcopy_parallel(slice<u32>(source, 0, 10),
+                                      slice<u32>(source, 5, 15)));
+
+            // small copies are not split up
+            tasks.clear();
+            REQUIRE(memcopy_parallel(slice<u32>(destination, 0, 100),
+                                     slice<u32>(source, 100, 200),
+                                     recording_executor{&tasks}));
+            REQUIRE(tasks.size() == 1);
+            REQUIRE(destination[0] == 100);
+
+            memfill_parallel(slice<u32>(destination), u32(9),
+                             thread_executor{3});
+            for (u32 item : destination) {
+                REQUIRE(item == 9);
+            }
+
+            std::fill(destination.begin(), destination.end(), 0);
+            REQUIRE(memcopy_parallel(slice<u32>(destination),
+                                     slice<u32>(source), thread_executor{3}));
+            REQUIRE(destination == source);
+
+            // nothing to do
+            memfill_parallel(slice<u32>(destination, 0, 0), u32(1));
+            REQUIRE(destination[0] == 0);
+        }
+
         SUBCASE("memcompare for string")
         {
             std::array<char, 512> chars;
@@ -49,6 +156,357 @@ TEST_SUITE("stdmem")
             REQUIRE(memcompare(strslice, array_strslice));
         }
 
+        SUBCASE("memcompare across vector widths")
+        {
+            std::array<u8, 300> a;
+            std::array<u8, 300> b;
+            for (size_t i = 0; i < a.size(); ++i) {
+                a[i] = u8(i * 7);
+                b[i] = u8(i * 7);
+            }
+
+            // every length and every mismatch position, so that the vector,
+            // word, and byte tails all get exercised
+            for (size_t length = 0; length <= 130; ++length) {
+                slice<u8> sa(a, 1, 1 + length);
+                slice<u8> sb(b, 3, 3 + length);
+                for (size_t i = 0; i < length; ++i) {
+                    sb.data()[i] = sa.data()[i];
+                }
+                REQUIRE(memcompare(sa, sb));
+                for (size_t i = 0; i < length; ++i) {
+                    sb.data()[i] ^= 0x10;
+                    REQUIRE(!memcompare(sa, sb));
+                    sb.data()[i] ^= 0x10;
+                }
+            }
+
+            std::array<u32, 100> ints_a{};
+            std::array<u32, 100> ints_b{};
+            REQUIRE(memcompare(slice<u32>(ints_a), slice<u32>(ints_b)));
+            ints_b[99] = 1 << 24;
+            REQUIRE(!memcompare(slice<u32>(ints_a), slice<u32>(ints_b)));
+        }
+
+#ifdef ZIGLIKE_HAS_CONSTANT_EVALUATED
+        SUBCASE("memcompare in constant evaluation")
+        {
+            static constexpr std::array<int, 5> a = {1, 2, 3, 4, 5};
+            static constexpr std::array<int, 5> b = {1, 2, 3, 4, 5};
+            static constexpr std::array<int, 5> c = {1, 2, 3, 4, 6};
+            static_assert(
+                memcompare(slice<const int>(a), slice<const int>(b)));
+            static_assert(
+                !memcompare(slice<const int>(a), slice<const int>(c)));
+        }
+#endif
+
+        SUBCASE("memorder")
+        {
+            std::array<u8, 200> a;
+            std::array<u8, 200> b;
+            for (size_t i = 0; i < a.size(); ++i) {
+                a[i] = u8(i);
+                b[i] = u8(i);
+            }
+            {
+                auto result = memorder(slice<u8>(a), slice<u8>(b));
+                REQUIRE(result.order == ordering::equal);
+                REQUIRE(result.index == 200);
+            }
+            for (size_t i = 0; i < b.size(); ++i) {
+                b[i] = u8(i + 1);
+                auto result = memorder(slice<u8>(a), slice<u8>(b));
+                REQUIRE(result.order == ordering::less);
+                REQUIRE(result.index == i);
+                result = memorder(slice<u8>(b), slice<u8>(a));
+                REQUIRE(result.order == ordering::greater);
+                REQUIRE(result.index == i);
+                b[i] = u8(i);
+            }
+
+            // prefix orders before the longer slice
+            {
+                auto result = memorder(slice<u8>(a, 0, 50), slice<u8>(b));
+                REQUIRE(result.order == ordering::less);
+                REQUIRE(result.index == 50);
+                result = memorder(slice<u8>(a), slice<u8>(a, 0, 50));
+                REQUIRE(result.order == ordering::greater);
+                REQUIRE(result.index == 50);
+            }
+
+            // integers are ordered by value, not by their little endian bytes
+            std::array<u32, 40> ints_a{};
+            std::array<u32, 40> ints_b{};
+            ints_a[33] = 0x00000100;
+            ints_b[33] = 0x00000001;
+            {
+                auto result =
+                    memorder(slice<u32>(ints_a), slice<u32>(ints_b));
+                REQUIRE(result.order == ordering::greater);
+                REQUIRE(result.index == 33);
+            }
+
+            std::array<i32, 3> signed_a = {0, -1, 0};
+            std::array<i32, 3> signed_b = {0, 1, 0};
+            REQUIRE(memorder(slice<i32>(signed_a), slice<i32>(signed_b))
+                        .order == ordering::less);
+
+#ifdef ZIGLIKE_HAS_CONSTANT_EVALUATED
+            static constexpr std::array<int, 4> const_a = {1, 2, 3, 4};
+            static constexpr std::array<int, 4> const_b = {1, 2, 4, 4};
+            static_assert(memorder(slice<const int>(const_a),
+                                   slice<const int>(const_b))
+                              .index == 2);
+#endif
+        }
+
+        SUBCASE("memgather and memscatter")
+        {
+            auto check = [](auto zero) {
+                using T = decltype(zero);
+                for (size_t stride : {1, 2, 3, 7, 16}) {
+                    std::vector<T> source(200 * stride);
+                    for (size_t i = 0; i < source.size(); ++i)
+                        source[i] = T(i);
+                    for (size_t count : {0, 1, 5, 9, 33, 200}) {
+                        strided_slice<T> strided(
+                            slice<T>(source, 0, count * stride), 0, stride);
+                        REQUIRE(strided.size() == count);
+                        std::vector<T> dense(count + 1);
+                        slice<T> dense_slice(dense, 0, count);
+                        REQUIRE(memgather(dense_slice, strided));
+                        for (size_t i = 0; i < count; ++i)
+                            REQUIRE(dense[i] == T(i * stride));
+
+                        for (T& item : dense)
+                            item = T(item + 1);
+                        REQUIRE(memscatter(strided, dense_slice));
+                        for (size_t i = 0; i < source.size(); ++i) {
+                            const bool written =
+                                i % stride == 0 && i / stride < count;
+                            REQUIRE(source[i] == T(written ? i + 1 : i));
+                        }
+                        for (size_t i = 0; i < source.size(); ++i)
+                            source[i] = T(i);
+                        if (count > 0) {
+                            REQUIRE(!memgather(slice<T>(dense), strided));
+                        }
+                    }
+                }
+            };
+            check(uint8_t{});
+            check(uint16_t{});
+            check(uint32_t{});
+            check(uint64_t{});
+            check(float{});
+            check(double{});
+
+            std::array<int, 8> mem = {};
+            strided_slice<int> evens(slice<int>(mem), 0, 2);
+            REQUIRE(!memgather(slice<int>(mem, 4, 8), evens));
+            REQUIRE(!memscatter(evens, slice<int>(mem, 1, 5)));
+
+            // an empty strided slice may point one past the end of its memory
+            strided_slice<int> empty(slice<int>(mem), 8, 3);
+            REQUIRE(memgather(slice<int>(mem, 0, 0), empty));
+            REQUIRE(memscatter(empty, slice<int>(mem, 0, 0)));
+            REQUIRE(!memgather(slice<int>(mem, 0, 1), empty));
+        }
+
+        SUBCASE("index_of_scalar and last_index_of_scalar")
+        {
+            std::array<u8, 300> bytes{};
+            std::array<u16, 300> shorts{};
+            std::array<u32, 300> ints{};
+            std::array<u64, 300> longs{};
+            std::array<f32, 300> floats{};
+            REQUIRE(!index_of_scalar(slice<u8>(bytes), u8(1)).has_value());
+            REQUIRE(!last_index_of_scalar(slice<u8>(bytes), u8(1)).has_value());
+            REQUIRE(!index_of_scalar(slice<u64>(longs), u64(1)).has_value());
+            REQUIRE(
+                !index_of_scalar(slice<u8>(bytes, 0, 0), u8(0)).has_value());
+
+            for (size_t i = 0; i < bytes.size(); i += 7) {
+                bytes[i] = 1;
+                shorts[i] = 1;
+                ints[i] = 1;
+                longs[i] = 1;
+                floats[i] = 1;
+                // the first occurrence is always 0, the last one is i
+                REQUIRE(index_of_scalar(slice<u8>(bytes), u8(1)) == size_t(0));
+                REQUIRE(index_of_scalar(slice<u16>(shorts), u16(1)) ==
+                        size_t(0));
+                REQUIRE(index_of_scalar(slice<u32>(ints), u32(1)) == size_t(0));
+                REQUIRE(index_of_scalar(slice<u64>(longs), u64(1)) ==
+                        size_t(0));
+                REQUIRE(index_of_scalar(slice<f32>(floats), 1.0f) == size_t(0));
+                REQUIRE(last_index_of_scalar(slice<u8>(bytes), u8(1)) == i);
+                REQUIRE(last_index_of_scalar(slice<u16>(shorts), u16(1)) == i);
+                REQUIRE(last_index_of_scalar(slice<u32>(ints), u32(1)) == i);
+                REQUIRE(last_index_of_scalar(slice<u64>(longs), u64(1)) == i);
+                REQUIRE(last_index_of_scalar(slice<f32>(floats), 1.0f) == i);
+            }
+
+            // a match in the upper half of a wide lane must not count
+            longs.fill(0);
+            longs[200] = u64(1) << 32;
+            REQUIRE(!index_of_scalar(slice<u64>(longs), u64(0x100000000) + 1)
+                         .has_value());
+            REQUIRE(index_of_scalar(slice<u64>(longs), u64(1) << 32) ==
+                    size_t(200));
+
+            const char* string = "hello, world";
+            slice<const char> chars = raw_slice(*string, std::strlen(string));
+            REQUIRE(index_of_scalar(chars, 'o') == size_t(4));
+            REQUIRE(last_index_of_scalar(chars, 'o') == size_t(8));
+            REQUIRE(!index_of_scalar(chars, 'z').has_value());
+        }
+
+        SUBCASE("index_of_any")
+        {
+            std::array<char, 200> text;
+            text.fill('a');
+            text[150] = ';';
+            text[170] = ',';
+            slice<char> sl(text);
+
+            const std::array<char, 2> separators = {',', ';'};
+            REQUIRE(index_of_any(sl, separators) == size_t(150));
+            const std::array<char, 1> comma = {','};
+            REQUIRE(index_of_any(sl, comma) == size_t(170));
+            const std::array<char, 3> missing = {'x', 'y', 'z'};
+            REQUIRE(!index_of_any(sl, missing).has_value());
+            REQUIRE(!index_of_any(sl, slice<const char>(missing, 0, 0))
+                         .has_value());
+
+            // more values than fit in the vector path
+            const std::array<char, 10> many = {'0', '1', '2', '3', '4',
+                                               '5', '6', '7', '8', ';'};
+            REQUIRE(index_of_any(sl, many) == size_t(150));
+
+            std::array<u32, 100> ints{};
+            ints[60] = 5;
+            ints[40] = 6;
+            const std::array<u32, 2> wanted = {5, 6};
+            REQUIRE(index_of_any(slice<u32>(ints), wanted) == size_t(40));
+        }
+
+#ifdef ZIGLIKE_HAS_CONSTANT_EVALUATED
+        SUBCASE("searching in constant evaluation")
+        {
+            static constexpr std::array<int, 6> items = {4, 1, 2, 1, 3, 1};
+            static constexpr std::array<int, 2> wanted = {3, 2};
+            static_assert(index_of_scalar(slice<const int>(items), 1) ==
+                          size_t(1));
+            static_assert(last_index_of_scalar(slice<const int>(items), 1) ==
+                          size_t(5));
+            static_assert(
+                !index_of_scalar(slice<const int>(items), 5).has_value());
+            static_assert(index_of_any(slice<const int>(items),
+                                       slice<const int>(wanted)) == size_t(2));
+            static_assert(count_scalar(slice<const int>(items), 1) == 3);
+        }
+#endif
+
+        SUBCASE("index_of")
+        {
+            const auto find = [](std::string_view haystack,
+                                 std::string_view needle) -> opt<size_t> {
+                return index_of(
+                    raw_slice(*haystack.data(), haystack.size()),
+                    raw_slice(*needle.data(), needle.size()));
+            };
+            REQUIRE(find("hello, world", "world") == size_t(7));
+            REQUIRE(find("hello, world", "hello") == size_t(0));
+            REQUIRE(find("hello, world", "o") == size_t(4));
+            REQUIRE(find("hello, world", "") == size_t(0));
+            REQUIRE(!find("hello", "hello, world").has_value());
+            REQUIRE(!find("hello, world", "worlds").has_value());
+
+            // compare against std::string_view::find on generated inputs,
+            // with small alphabets so there are lots of partial matches and
+            // periodic needles
+            u32 state = 12345;
+            const auto next = [&state]() {
+                state = state * 1664525 + 1013904223;
+                return state >> 16;
+            };
+            for (size_t round = 0; round < 2000; ++round) {
+                const size_t alphabet = 1 + (next() % 3);
+                std::string haystack(next() % 300, 'a');
+                for (char& c : haystack) {
+                    c = char('a' + (next() % alphabet));
+                }
+                std::string needle(1 + (next() % 12), 'a');
+                for (char& c : needle) {
+                    c = char('a' + (next() % alphabet));
+                }
+                const size_t expected = std::string_view(haystack).find(needle);
+                const opt<size_t> found = find(haystack, needle);
+                if (expected == std::string_view::npos) {
+                    REQUIRE(!found.has_value());
+                } else {
+                    REQUIRE(found == expected);
+                }
+            }
+
+            // adversarial input where the first and last byte filter matches
+            // everywhere, forcing the switch to Two-Way
+            std::string many_a(5000, 'a');
+            std::string needle(100, 'a');
+            needle[50] = 'b';
+            REQUIRE(!find(many_a, needle).has_value());
+            many_a.replace(4000, needle.size(), needle);
+            REQUIRE(find(many_a, needle) == size_t(4000));
+
+            // wider items
+            std::array<u32, 100> ints{};
+            for (size_t i = 0; i < ints.size(); ++i) {
+                ints[i] = u32(i % 10);
+            }
+            const std::array<u32, 3> sequence = {7, 8, 9};
+            REQUIRE(index_of(slice<u32>(ints), sequence) == size_t(7));
+            const std::array<u32, 3> missing = {9, 8, 7};
+            REQUIRE(!index_of(slice<u32>(ints), missing).has_value());
+
+            // types which are not vector searchable use their == operator
+            std::array<f32, 5> floats = {1, 2, 3, 2, 3};
+            const std::array<f32, 2> float_needle = {2, 3};
+            REQUIRE(index_of(slice<f32>(floats), float_needle) == size_t(1));
+
+#ifdef ZIGLIKE_HAS_CONSTANT_EVALUATED
+            static constexpr std::array<int, 6> items = {4, 1, 2, 1, 2, 3};
+            static constexpr std::array<int, 3> tail = {1, 2, 3};
+            static constexpr std::array<int, 2> absent = {3, 4};
+            static_assert(index_of(slice<const int>(items),
+                                   slice<const int>(tail)) == size_t(3));
+            static_assert(!index_of(slice<const int>(items),
+                                    slice<const int>(absent))
+                               .has_value());
+#endif
+        }
+
+        SUBCASE("count_scalar")
+        {
+            std::array<u8, 257> bytes{};
+            std::array<u32, 257> ints{};
+            std::array<f64, 257> doubles{};
+            size_t expected = 0;
+            for (size_t i = 0; i < bytes.size(); i += 3) {
+                bytes[i] = 9;
+                ints[i] = 9;
+                doubles[i] = 9;
+                ++expected;
+            }
+            REQUIRE(count_scalar(slice<u8>(bytes), u8(9)) == expected);
+            REQUIRE(count_scalar(slice<u32>(ints), u32(9)) == expected);
+            REQUIRE(count_scalar(slice<f64>(doubles), 9.0) == expected);
+            REQUIRE(count_scalar(slice<u8>(bytes), u8(0)) ==
+                    bytes.size() - expected);
+            REQUIRE(count_scalar(slice<u8>(bytes, 0, 0), u8(0)) == 0);
+        }
+
         SUBCASE("memoverlaps")
         {
             std::array<u8, 512> bytes;
@@ -75,6 +533,73 @@ TEST_SUITE("stdmem")
             }
         }
 
+        SUBCASE("memfill for wider types")
+        {
+            struct odd_sized_t
+            {
+                u8 bytes[12];
+            };
+            static_assert(sizeof(odd_sized_t) == 12);
+
+            std::array<u32, 300> ints;
+            std::array<f32, 300> floats;
+            std::array<u64, 300> longs;
+            std::array<odd_sized_t, 300> odds;
+            const odd_sized_t odd = {{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}};
+
+            // all offsets and lengths, so that every tail gets tested
+            for (size_t from = 0; from < 4; ++from) {
+                for (size_t to = from; to < 140; ++to) {
+                    ints.fill(0);
+                    floats.fill(0);
+                    longs.fill(0);
+                    memfill(slice<u32>(ints, from, to), u32(0xDEADBEEF));
+                    memfill(slice<f32>(floats, from, to), 1.5f);
+                    memfill(slice<u64>(longs, from, to),
+                            u64(0x0102030405060708));
+                    memfill(slice<odd_sized_t>(odds, from, to), odd);
+                    for (size_t i = 0; i < 300; ++i) {
+                        const bool inside = i >= from && i < to;
+                        REQUIRE(ints[i] == (inside ? 0xDEADBEEF : 0));
+                        REQUIRE(floats[i] == (inside ? 1.5f : 0.0f));
+                        REQUIRE(longs[i] ==
+                                (inside ? 0x0102030405060708 : 0));
+                        if (inside) {
+                            REQUIRE(std::memcmp(&odds[i], &odd,
+                                                sizeof(odd)) == 0);
+                        }
+                    }
+                }
+            }
+        }
+
+        SUBCASE("memfill_streaming")
+        {
+            std::array<u32, 600> ints;
+            std::array<u8, 600 * sizeof(u32)> bytes;
+            for (size_t from = 0; from < 9; ++from) {
+                for (size_t to = from; to < 600; to += 37) {
+                    ints.fill(0);
+                    bytes.fill(0);
+                    // threshold of zero, always stream
+                    memfill_streaming(slice<u32>(ints, from, to),
+                                      u32(0x11223344), 0);
+                    memfill_streaming(slice<u8>(bytes, from, to), u8(9), 0);
+                    for (size_t i = 0; i < ints.size(); ++i) {
+                        const bool inside = i >= from && i < to;
+                        REQUIRE(ints[i] == (inside ? 0x11223344 : 0));
+                        REQUIRE(bytes[i] == (inside ? 9 : 0));
+                    }
+                }
+            }
+
+            // under the threshold it is just a memfill
+            memfill_streaming(slice<u32>(ints), u32(7));
+            for (u32 i : ints) {
+                REQUIRE(i == 7);
+            }
+        }
+
         SUBCASE("memcontains")
         {
             std::array<u8, 512> bytes;
@@ -119,5 +644,117 @@ TEST_SUITE("stdmem")
             REQUIRE(!memcontains_one(tmem_bytes, tests.data() + 201));
             REQUIRE(memcontains_one(tmem_bytes, tests.data() + 199));
         }
+
+        SUBCASE("as_bytes, as_writable_bytes, and bytes_as")
+        {
+            struct record
+            {
+                uint32_t id;
+                uint16_t flags;
+                uint16_t length;
+            };
+            std::array<record, 3> records = {
+                record{1, 2, 3}, record{4, 5, 6}, record{7, 8, 9}};
+            slice<record> records_slice(records);
+
+            slice<const uint8_t> bytes = as_bytes(records_slice);
+            REQUIRE(bytes.size() == sizeof(records));
+            REQUIRE(static_cast<const void*>(bytes.data()) == records.data());
+            slice<uint8_t> writable = as_writable_bytes(records_slice);
+            REQUIRE(writable.size() == sizeof(records));
+
+            // round trip through bytes
+            alignas(record) std::array<uint8_t, sizeof(records)> wire = {};
+            REQUIRE(memcopy(slice<uint8_t>(wire), writable));
+            opt<slice<const record>> decoded =
+                bytes_as<const record>(slice<const uint8_t>(wire));
+            REQUIRE(decoded.has_value());
+            REQUIRE(decoded.value().size() == 3);
+            REQUIRE(decoded.value().data()[2].id == 7);
+            REQUIRE(decoded.value().data()[1].length == 6);
+
+            opt<slice<record>> mutable_decoded =
+                bytes_as<record>(slice<uint8_t>(wire));
+            REQUIRE(mutable_decoded.has_value());
+            mutable_decoded.value().data()[0].flags = 42;
+            REQUIRE(decoded.value().data()[0].flags == 42);
+
+            // wrong size
+            REQUIRE(!bytes_as<const record>(
+                         slice<const uint8_t>(wire, 0, sizeof(record) + 1))
+                         .has_value());
+            // misaligned
+            REQUIRE(!bytes_as<const record>(slice<const uint8_t>(
+                         wire, 1, 1 + sizeof(record)))
+                         .has_value());
+            // empty is fine
+            REQUIRE(bytes_as<const record>(slice<const uint8_t>(wire, 0, 0))
+                        .has_value());
+        }
+
+        SUBCASE("joined slices")
+        {
+            std::array<int, 12> mem = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+            slice<int> all(mem);
+            std::array<slice<int>, 5> segments = {
+                all.first(3), all.subslice(3, 3), all.subslice(3, 4),
+                all.subslice(4, 9), all.drop_front(9)};
+            joined_slice<int> joined(segments);
+
+            std::array<int, 12> flat = {};
+            REQUIRE(memcopy(slice<int>(flat), joined));
+            REQUIRE(flat == mem);
+            REQUIRE(memcompare(joined, slice<int>(flat)));
+            flat[11] = 0;
+            REQUIRE(!memcompare(joined, slice<int>(flat)));
+            REQUIRE(!memcompare(joined, slice<int>(flat).first(11)));
+            // size mismatch and overlap
+            REQUIRE(!memcopy(slice<int>(flat).first(11), joined));
+            REQUIRE(!memcopy(all, joined));
+
+            std::array<int, 12> other = {};
+            slice<int> other_all(other);
+            std::array<slice<int>, 3> other_segments = {
+                other_all.first(5), other_all.subslice(5, 5),
+                other_all.drop_front(5)};
+            joined_slice<int> other_joined(other_segments);
+            REQUIRE(memcopy(other_joined, slice<int>(flat)));
+            REQUIRE(other[10] == 10);
+            REQUIRE(other[11] == 0);
+            REQUIRE(!memcompare(joined, other_joined));
+            other[11] = 11;
+            REQUIRE(memcompare(joined, other_joined));
+            REQUIRE(memcompare(other_joined, joined));
+            REQUIRE(!memcopy(other_joined, slice<int>(flat).first(3)));
+        }
+
+        SUBCASE("index_of for joined slices")
+        {
+            const char* text = "the quick brown fox";
+            slice<const char> all = raw_slice(*text, std::strlen(text));
+            // split the text at awkward places, with an empty segment
+            std::array<slice<const char>, 5> segments = {
+                all.first(5), all.subslice(5, 11), all.subslice(11, 11),
+                all.subslice(11, 12), all.drop_front(12)};
+            slice<const slice<const char>> segments_slice = segments;
+            joined_slice<const char> joined(segments_slice);
+
+            const auto find = [&joined](const char* needle) {
+                return index_of(joined,
+                                raw_slice(*needle, std::strlen(needle)));
+            };
+            // inside of one segment
+            REQUIRE(find("the").value() == 0);
+            REQUIRE(find("fox").value() == 16);
+            // across one boundary
+            REQUIRE(find("quick").value() == 4);
+            // across an empty segment and several boundaries
+            REQUIRE(find("k brown f").value() == 8);
+            REQUIRE(find("the quick brown fox").value() == 0);
+            REQUIRE(find(" ").value() == 3);
+            REQUIRE(!find("foxes").has_value());
+            REQUIRE(!find("quack").has_value());
+            REQUIRE(index_of(joined, all.first(0)).value() == 0);
+        }
     }
 }
@@ -0,0 +1,143 @@
+#include "test_header.h"
+// test header must be first
+#include "ziglike/enumerate.h"
+#include "ziglike/strided_slice.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using namespace zl;
+
+static_assert(!std::is_default_constructible_v<strided_slice<int>>,
+              "strided slice should not be default constructible");
+static_assert(
+    std::is_same_v<std::iterator_traits<
+                       strided_slice<int>::iterator>::iterator_category,
+                   std::random_access_iterator_tag>,
+    "strided slice iterators should be random access");
+
+TEST_SUITE("strided_slice")
+{
+    TEST_CASE("construction")
+    {
+        SUBCASE("size from offset and stride")
+        {
+            std::array<int, 10> mem = {};
+            slice<int> ints(mem);
+
+            REQUIRE(strided_slice<int>(ints, 0, 1).size() == 10);
+            REQUIRE(strided_slice<int>(ints, 0, 3).size() == 4);
+            REQUIRE(strided_slice<int>(ints, 1, 3).size() == 3);
+            REQUIRE(strided_slice<int>(ints, 9, 3).size() == 1);
+            REQUIRE(strided_slice<int>(ints, 10, 3).size() == 0);
+            REQUIRE(strided_slice<int>(ints, 0, 100).size() == 1);
+            REQUIREABORTS(strided_slice<int>(ints, 11, 1));
+            REQUIREABORTS(strided_slice<int>(ints, 0, 0));
+
+            strided_slice<int> column(ints, 2, 5);
+            REQUIRE(column.data() == &mem[2]);
+            REQUIRE(column.stride() == 5);
+        }
+
+        SUBCASE("conversions")
+        {
+            std::array<int, 10> mem = {};
+            slice<int> ints(mem);
+            strided_slice<int> all = ints;
+            REQUIRE(all.size() == 10);
+            REQUIRE(all.stride() == 1);
+
+            strided_slice<int> odds(ints, 1, 2);
+            strided_slice<const int> const_odds = odds;
+            REQUIRE(const_odds.data() == odds.data());
+            REQUIRE(const_odds.size() == odds.size());
+            REQUIRE(strided_slice<int>(ints, 1, 2) == odds);
+            REQUIRE(strided_slice<int>(ints, 0, 2) != odds);
+        }
+    }
+
+    TEST_CASE("access")
+    {
+        SUBCASE("column of a row major matrix")
+        {
+            constexpr size_t rows = 4;
+            constexpr size_t columns = 3;
+            std::array<int, rows * columns> matrix;
+            for (size_t i = 0; i < matrix.size(); ++i)
+                matrix[i] = int(i);
+
+            strided_slice<int> column(slice<int>(matrix), 1, columns);
+            REQUIRE(column.size() == rows);
+            for (size_t row = 0; row < rows; ++row)
+                REQUIRE(column[row] == int((row * columns) + 1));
+
+            column[2] = -1;
+            REQUIRE(matrix[7] == -1);
+            REQUIRE(&column.at(3).value() == &matrix[10]);
+            REQUIRE(!column.at(4).has_value());
+            REQUIRE(&column.unchecked_at(0) == &matrix[1]);
+#ifdef ZIGLIKE_BOUNDS_CHECKED
+            REQUIREABORTS((void)column[4]);
+#endif
+        }
+
+        SUBCASE("iteration")
+        {
+            // two channels of interleaved audio
+            std::array<float, 8> samples = {0, 10, 1, 11, 2, 12, 3, 13};
+            strided_slice<float> right(slice<float>(samples), 1, 2);
+
+            float expected = 10;
+            for (float& sample : right) {
+                REQUIRE(sample == expected);
+                sample = -sample;
+                ++expected;
+            }
+            REQUIRE(samples[7] == -13);
+
+            REQUIRE(right.end() - right.begin() == 4);
+            REQUIRE(*(right.begin() + 2) == -12);
+            REQUIRE(right.begin()[3] == -13);
+            auto last = right.end();
+            --last;
+            REQUIRE(&*last == &samples[7]);
+
+            std::sort(right.begin(), right.end());
+            REQUIRE(samples == std::array<float, 8>{0, -13, 1, -12, 2, -11,
+                                                    3, -10});
+        }
+
+        SUBCASE("empty")
+        {
+            std::array<int, 6> mem = {};
+            // data() is one past the end of mem, and must never be stepped
+            // from or dereferenced
+            strided_slice<int> empty(slice<int>(mem), 6, 4);
+            REQUIRE(empty.size() == 0);
+            REQUIRE(empty.begin() == empty.end());
+            REQUIRE(empty.end() - empty.begin() == 0);
+            for (int& item : empty) {
+                (void)item;
+                REQUIRE(false);
+            }
+            REQUIRE(!empty.at(0).has_value());
+        }
+
+        SUBCASE("enumerate")
+        {
+            std::array<int, 9> mem = {};
+            strided_slice<int> diagonal(slice<int>(mem), 0, 4);
+            for (auto [item, index] : enumerate_mut(diagonal)) {
+                item = int(index) + 1;
+            }
+            REQUIRE(mem == std::array<int, 9>{1, 0, 0, 0, 2, 0, 0, 0, 3});
+
+            size_t count = 0;
+            for (auto [item, index] : enumerate(diagonal)) {
+                REQUIRE(item == int(index) + 1);
+                ++count;
+            }
+            REQUIRE(count == 3);
+        }
+    }
+}